@@ -1,1405 +1,6480 @@
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <map>
-#include <iomanip>
-#include <ctime>
-#include <sstream>
-#include <algorithm>
-#include <limits>
-#include <cctype>
-
-using namespace std;
-
- 
-string generateId(const string& prefix) {
-    static int counter = 1000;
-    return prefix + to_string(counter++);
-}
-
-string getCurrentDate() {
-    time_t now = time(0);
-    tm* ltm = localtime(&now);
-    return to_string(ltm->tm_mday) + "/" + 
-           to_string(1 + ltm->tm_mon) + "/" + 
-           to_string(1900 + ltm->tm_year);
-}
-
-void clearScreen() {
-    #ifdef _WIN32
-        system("cls");
-    #else
-        system("clear");
-    #endif
-}
-
-void pauseScreen() {
-    cout << "\nPress Enter to continue...";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    cin.get();
-}
-
-string toUpper(const string& str) {
-    string result = str;
-    transform(result.begin(), result.end(), result.begin(), ::toupper);
-    return result;
-}
-
-bool isValidEmail(const string& email) {
-    return email.find('@') != string::npos && email.find('.') != string::npos;
-}
-
-bool isValidPhone(const string& phone) {
-    return phone.length() >= 10 && all_of(phone.begin(), phone.end(), ::isdigit);
-}
-
-
-class User {
-protected:
-    string userId;
-    string password;
-    string name;
-    string email;
-    string userType;
-
-public:
-    User() : userId(""), password(""), name(""), email(""), userType("") {}
-    
-    User(string id, string pass, string n, string mail, string type)
-        : userId(id), password(pass), name(n), email(mail), userType(type) {}
-    
-    virtual ~User() {}
-    
-    virtual void displayInfo() const {
-        cout << "User ID: " << userId << endl;
-        cout << "Name: " << name << endl;
-        cout << "Email: " << email << endl;
-        cout << "Role: " << userType << endl;
-    }
-    
-    virtual string getRole() const = 0;
-    
-    string getUserId() const { return userId; }
-    string getPassword() const { return password; }
-    string getName() const { return name; }
-    string getEmail() const { return email; }
-    string getUserType() const { return userType; }
-    
-    void setPassword(string pass) { password = pass; }
-    void setName(string n) { name = n; }
-    void setEmail(string mail) { email = mail; }
-};
-
- 
-class Passenger : public User {
-private:
-    string phone;
-    string passportNumber;
-    vector<string> bookingIds;
-
-public:
-    Passenger() : User(), phone(""), passportNumber("") {}
-    
-    Passenger(string id, string pass, string n, string mail, string ph, string passport)
-        : User(id, pass, n, mail, "PASSENGER"), phone(ph), passportNumber(passport) {}
-    
-    void displayInfo() const override {
-        User::displayInfo();
-        cout << "Phone: " << phone << endl;
-        cout << "Passport: " << passportNumber << endl;
-        cout << "Total Bookings: " << bookingIds.size() << endl;
-    }
-    
-    string getRole() const override { return "PASSENGER"; }
-    
-    string getPhone() const { return phone; }
-    string getPassportNumber() const { return passportNumber; }
-    vector<string> getBookingIds() const { return bookingIds; }
-    
-    void addBooking(string bookingId) {
-        bookingIds.push_back(bookingId);
-    }
-    
-    void removeBooking(string bookingId) {
-        auto it = find(bookingIds.begin(), bookingIds.end(), bookingId);
-        if (it != bookingIds.end()) {
-            bookingIds.erase(it);
-        }
-    }
-    
-    string toFileString() const {
-        string bookings = "";
-        for (size_t i = 0; i < bookingIds.size(); i++) {
-            bookings += bookingIds[i];
-            if (i < bookingIds.size() - 1) bookings += ",";
-        }
-        return userId + "|" + password + "|" + name + "|" + email + "|" + 
-               phone + "|" + passportNumber + "|" + bookings;
-    }
-    
-    static Passenger fromFileString(const string& line) {
-        size_t pos = 0, prev = 0;
-        vector<string> tokens;
-        
-        while ((pos = line.find('|', prev)) != string::npos) {
-            tokens.push_back(line.substr(prev, pos - prev));
-            prev = pos + 1;
-        }
-        tokens.push_back(line.substr(prev));
-        
-        if (tokens.size() < 6) return Passenger();
-        
-        Passenger p(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4], tokens[5]);
-        
-        if (tokens.size() > 6 && !tokens[6].empty()) {
-            size_t bPos = 0, bPrev = 0;
-            while ((bPos = tokens[6].find(',', bPrev)) != string::npos) {
-                p.addBooking(tokens[6].substr(bPrev, bPos - bPrev));
-                bPrev = bPos + 1;
-            }
-            if (bPrev < tokens[6].length()) {
-                p.addBooking(tokens[6].substr(bPrev));
-            }
-        }
-        
-        return p;
-    }
-};
-
-
-class Admin : public User {
-private:
-    string adminLevel;
-
-public:
-    Admin() : User(), adminLevel("") {}
-    
-    Admin(string id, string pass, string n, string mail, string level)
-        : User(id, pass, n, mail, "ADMIN"), adminLevel(level) {}
-    
-    void displayInfo() const override {
-        User::displayInfo();
-        cout << "Admin Level: " << adminLevel << endl;
-    }
-    
-    string getRole() const override { return "ADMIN"; }
-    string getAdminLevel() const { return adminLevel; }
-    
-    string toFileString() const {
-        return userId + "|" + password + "|" + name + "|" + email + "|" + adminLevel;
-    }
-    
-    static Admin fromFileString(const string& line) {
-        size_t pos = 0, prev = 0;
-        vector<string> tokens;
-        
-        while ((pos = line.find('|', prev)) != string::npos) {
-            tokens.push_back(line.substr(prev, pos - prev));
-            prev = pos + 1;
-        }
-        tokens.push_back(line.substr(prev));
-        
-        if (tokens.size() < 5) return Admin();
-        
-        return Admin(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4]);
-    }
-};
-
- 
-class Flight {
-private:
-    string flightNumber;
-    string airline;
-    string origin;
-    string destination;
-    string departureDate;
-    string departureTime;
-    string arrivalTime;
-    int totalSeats;
-    int availableSeats;
-    double baseFare;
-    map<string, bool> seatMap;
-
-public:
-    Flight() : totalSeats(0), availableSeats(0), baseFare(0.0) {}
-    
-    Flight(string num, string air, string org, string dest, string date,
-           string depTime, string arrTime, int seats, double fare)
-        : flightNumber(num), airline(air), origin(org), destination(dest),
-          departureDate(date), departureTime(depTime), arrivalTime(arrTime),
-          totalSeats(seats), availableSeats(seats), baseFare(fare) {
-        
-        initializeSeats();
-    }
-    
-    void initializeSeats() {
-        char rows[] = {'A', 'B', 'C', 'D', 'E', 'F'};
-        int numRows = (totalSeats + 5) / 6;
-        
-        for (int i = 1; i <= numRows; i++) {
-            for (char c : rows) {
-                if (seatMap.size() < (size_t)totalSeats) {
-                    string seat = string(1, c) + to_string(i);
-                    seatMap[seat] = true;
-                }
-            }
-        }
-    }
-    
-    bool bookSeat(string seatNum) {
-        if (seatMap.find(seatNum) != seatMap.end() && seatMap[seatNum]) {
-            seatMap[seatNum] = false;
-            availableSeats--;
-            return true;
-        }
-        return false;
-    }
-    
-    bool cancelSeat(string seatNum) {
-        if (seatMap.find(seatNum) != seatMap.end() && !seatMap[seatNum]) {
-            seatMap[seatNum] = true;
-            availableSeats++;
-            return true;
-        }
-        return false;
-    }
-    
-    bool isSeatAvailable(string seatNum) const {
-        auto it = seatMap.find(seatNum);
-        return it != seatMap.end() && it->second;
-    }
-    
-    vector<string> getAvailableSeats() const {
-        vector<string> available;
-        for (const auto& seat : seatMap) {
-            if (seat.second) {
-                available.push_back(seat.first);
-            }
-        }
-        return available;
-    }
-    
-    void displayFlightInfo() const {
-        cout << "\n========================================" << endl;
-        cout << "Flight: " << flightNumber << " (" << airline << ")" << endl;
-        cout << "Route: " << origin << " -> " << destination << endl;
-        cout << "Date: " << departureDate << endl;
-        cout << "Departure: " << departureTime << " | Arrival: " << arrivalTime << endl;
-        cout << "Available Seats: " << availableSeats << "/" << totalSeats << endl;
-        cout << "Base Fare: ₹" << fixed << setprecision(2) << baseFare << endl;
-        cout << "========================================" << endl;
-    }
-    
-    void displaySeatMap() const {
-        cout << "\n=== SEAT MAP (O = Available, X = Booked) ===" << endl;
-        cout << "     A  B  C    D  E  F" << endl;
-        
-        int numRows = (totalSeats + 5) / 6;
-        for (int i = 1; i <= numRows; i++) {
-            cout << setw(2) << i << "  ";
-            char cols[] = {'A', 'B', 'C', 'D', 'E', 'F'};
-            for (int j = 0; j < 6; j++) {
-                string seat = string(1, cols[j]) + to_string(i);
-                if (seatMap.find(seat) != seatMap.end()) {
-                    cout << " " << (seatMap.at(seat) ? "O" : "X") << " ";
-                } else {
-                    cout << "   ";
-                }
-                if (j == 2) cout << "  ";
-            }
-            cout << endl;
-        }
-        cout << "=============================================" << endl;
-    }
-    
-    string getFlightNumber() const { return flightNumber; }
-    string getAirline() const { return airline; }
-    string getOrigin() const { return origin; }
-    string getDestination() const { return destination; }
-    string getDepartureDate() const { return departureDate; }
-    string getDepartureTime() const { return departureTime; }
-    string getArrivalTime() const { return arrivalTime; }
-    int getAvailableSeatsCount() const { return availableSeats; }
-    int getTotalSeats() const { return totalSeats; }
-    double getBaseFare() const { return baseFare; }
-    
-    void setAvailableSeats(int seats) { availableSeats = seats; }
-    
-    string toFileString() const {
-        string bookedSeats = "";
-        for (auto& seat : seatMap) {
-            if (!seat.second) {
-                bookedSeats += seat.first + ",";
-            }
-        }
-        if (!bookedSeats.empty()) bookedSeats.pop_back();
-        
-        return flightNumber + "|" + airline + "|" + origin + "|" + destination + "|" +
-               departureDate + "|" + departureTime + "|" + arrivalTime + "|" +
-               to_string(totalSeats) + "|" + to_string(availableSeats) + "|" +
-               to_string(baseFare) + "|" + bookedSeats;
-    }
-    
-    static Flight fromFileString(const string& line) {
-        size_t pos = 0, prev = 0;
-        vector<string> tokens;
-        
-        while ((pos = line.find('|', prev)) != string::npos) {
-            tokens.push_back(line.substr(prev, pos - prev));
-            prev = pos + 1;
-        }
-        tokens.push_back(line.substr(prev));
-        
-        if (tokens.size() < 10) return Flight();
-        
-        Flight f(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4],
-                 tokens[5], tokens[6], stoi(tokens[7]), stod(tokens[9]));
-        
-        f.setAvailableSeats(stoi(tokens[8]));
-        
-        if (tokens.size() > 10 && !tokens[10].empty()) {
-            size_t sPos = 0, sPrev = 0;
-            while ((sPos = tokens[10].find(',', sPrev)) != string::npos) {
-                f.bookSeat(tokens[10].substr(sPrev, sPos - sPrev));
-                sPrev = sPos + 1;
-            }
-            if (sPrev < tokens[10].length()) {
-                f.bookSeat(tokens[10].substr(sPrev));
-            }
-        }
-        
-        return f;
-    }
-};
-
- 
-class Booking {
-private:
-    string bookingId;
-    string passengerId;
-    string flightNumber;
-    string seatNumber;
-    string bookingDate;
-    double totalFare;
-    string status;
-
-public:
-    Booking() : totalFare(0.0), status("PENDING") {}
-    
-    Booking(string bId, string pId, string fNum, string seat, double fare)
-        : bookingId(bId), passengerId(pId), flightNumber(fNum),
-          seatNumber(seat), totalFare(fare), status("CONFIRMED") {
-        bookingDate = getCurrentDate();
-    }
-    
-    void displayBookingInfo() const {
-        cout << "\n======== BOOKING DETAILS ========" << endl;
-        cout << "Booking ID: " << bookingId << endl;
-        cout << "Passenger ID: " << passengerId << endl;
-        cout << "Flight Number: " << flightNumber << endl;
-        cout << "Seat Number: " << seatNumber << endl;
-        cout << "Booking Date: " << bookingDate << endl;
-        cout << "Total Fare: ₹" << fixed << setprecision(2) << totalFare << endl;
-        cout << "Status: " << status << endl;
-        cout << "=================================" << endl;
-    }
-    
-    string getBookingId() const { return bookingId; }
-    string getPassengerId() const { return passengerId; }
-    string getFlightNumber() const { return flightNumber; }
-    string getSeatNumber() const { return seatNumber; }
-    string getStatus() const { return status; }
-    double getTotalFare() const { return totalFare; }
-    
-    void setStatus(string s) { status = s; }
-    
-    string toFileString() const {
-        return bookingId + "|" + passengerId + "|" + flightNumber + "|" +
-               seatNumber + "|" + bookingDate + "|" + to_string(totalFare) + "|" + status;
-    }
-    
-    static Booking fromFileString(const string& line) {
-        size_t pos = 0, prev = 0;
-        vector<string> tokens;
-        
-        while ((pos = line.find('|', prev)) != string::npos) {
-            tokens.push_back(line.substr(prev, pos - prev));
-            prev = pos + 1;
-        }
-        tokens.push_back(line.substr(prev));
-        
-        if (tokens.size() < 7) return Booking();
-        
-        Booking b(tokens[0], tokens[1], tokens[2], tokens[3], stod(tokens[5]));
-        b.bookingDate = tokens[4];
-        b.status = tokens[6];
-        
-        return b;
-    }
-};
-
-
-class ReservationSystem {
-private:
-    vector<Passenger> passengers;
-    vector<Admin> admins;
-    vector<Flight> flights;
-    vector<Booking> bookings;
-    
-    Passenger* currentPassenger;
-    Admin* currentAdmin;
-    
-    const string PASSENGERS_FILE = "passengers.txt";
-    const string ADMINS_FILE = "admins.txt";
-    const string FLIGHTS_FILE = "flights.txt";
-    const string BOOKINGS_FILE = "bookings.txt";
-
-public:
-    ReservationSystem() : currentPassenger(nullptr), currentAdmin(nullptr) {
-        loadAllData();
-        initializeSampleData();
-    }
-    
-    ~ReservationSystem() {
-        saveAllData();
-    }
-    
-    void initializeSampleData() {
-
-        if (admins.empty()) {
-            admins.push_back(Admin("admin", "admin123", "System Admin", "admin@airline.com", "SUPER"));
-            saveAdmins();
-        }
-
-        if (flights.empty()) {
-            flights.push_back(Flight("AI101", "Air India", "New Delhi", "Mumbai", 
-                                   "15/10/2025", "08:00", "10:30", 48, 5500.00));
-            flights.push_back(Flight("AI102", "Air India", "Mumbai", "Bangalore", 
-                                   "15/10/2025", "11:00", "13:30", 48, 4200.00));
-            flights.push_back(Flight("SG201", "SpiceJet", "Bangalore", "Chennai", 
-                                   "16/10/2025", "14:00", "15:30", 42, 3800.00));
-            flights.push_back(Flight("IG301", "IndiGo", "Chennai", "Kolkata", 
-                                   "16/10/2025", "17:00", "19:30", 54, 6500.00));
-            flights.push_back(Flight("AI103", "Air India", "Delhi", "Goa", 
-                                   "17/10/2025", "07:00", "09:30", 36, 7200.00));
-            saveFlights();
-        }
-    }
-    
-
-    void saveAllData() {
-        savePassengers();
-        saveAdmins();
-        saveFlights();
-        saveBookings();
-    }
-    
-    void loadAllData() {
-        loadPassengers();
-        loadAdmins();
-        loadFlights();
-        loadBookings();
-    }
-    
-    void savePassengers() {
-        ofstream file(PASSENGERS_FILE);
-        if (file.is_open()) {
-            for (const auto& p : passengers) {
-                file << p.toFileString() << endl;
-            }
-            file.close();
-        }
-    }
-    
-    void loadPassengers() {
-        ifstream file(PASSENGERS_FILE);
-        if (file.is_open()) {
-            string line;
-            while (getline(file, line)) {
-                if (!line.empty()) {
-                    passengers.push_back(Passenger::fromFileString(line));
-                }
-            }
-            file.close();
-        }
-    }
-    
-    void saveAdmins() {
-        ofstream file(ADMINS_FILE);
-        if (file.is_open()) {
-            for (const auto& a : admins) {
-                file << a.toFileString() << endl;
-            }
-            file.close();
-        }
-    }
-    
-    void loadAdmins() {
-        ifstream file(ADMINS_FILE);
-        if (file.is_open()) {
-            string line;
-            while (getline(file, line)) {
-                if (!line.empty()) {
-                    admins.push_back(Admin::fromFileString(line));
-                }
-            }
-            file.close();
-        }
-    }
-    
-    void saveFlights() {
-        ofstream file(FLIGHTS_FILE);
-        if (file.is_open()) {
-            for (const auto& f : flights) {
-                file << f.toFileString() << endl;
-            }
-            file.close();
-        }
-    }
-    
-    void loadFlights() {
-        ifstream file(FLIGHTS_FILE);
-        if (file.is_open()) {
-            string line;
-            while (getline(file, line)) {
-                if (!line.empty()) {
-                    flights.push_back(Flight::fromFileString(line));
-                }
-            }
-            file.close();
-        }
-    }
-    
-    void saveBookings() {
-        ofstream file(BOOKINGS_FILE);
-        if (file.is_open()) {
-            for (const auto& b : bookings) {
-                file << b.toFileString() << endl;
-            }
-            file.close();
-        }
-    }
-    
-    void loadBookings() {
-        ifstream file(BOOKINGS_FILE);
-        if (file.is_open()) {
-            string line;
-            while (getline(file, line)) {
-                if (!line.empty()) {
-                    bookings.push_back(Booking::fromFileString(line));
-                }
-            }
-            file.close();
-        }
-    }
-    
-
-    void registerPassenger() {
-        clearScreen();
-        cout << "\n=====================================" << endl;
-        cout << "     PASSENGER REGISTRATION         " << endl;
-        cout << "=====================================" << endl;
-        
-        string name, email, phone, passport, password;
-        
-        cin.ignore();
-        cout << "\nEnter Full Name: ";
-        getline(cin, name);
-        
-        cout << "Enter Email: ";
-        getline(cin, email);
-        while (!isValidEmail(email)) {
-            cout << "Invalid email format! Enter again: ";
-            getline(cin, email);
-        }
-        
-        cout << "Enter Phone: ";
-        getline(cin, phone);
-        while (!isValidPhone(phone)) {
-            cout << "Invalid phone number! Enter 10 digits: ";
-            getline(cin, phone);
-        }
-        
-        cout << "Enter Passport Number: ";
-        getline(cin, passport);
-        
-        cout << "Enter Password: ";
-        getline(cin, password);
-        while (password.length() < 4) {
-            cout << "Password too short! Minimum 4 characters: ";
-            getline(cin, password);
-        }
-        
-        for (const auto& p : passengers) {
-            if (p.getEmail() == email) {
-                cout << "\nERROR: Email already registered!" << endl;
-                pauseScreen();
-                return;
-            }
-        }
-        
-        string userId = generateId("P");
-        Passenger newPassenger(userId, password, name, email, phone, passport);
-        passengers.push_back(newPassenger);
-        savePassengers();
-        
-        cout << "\nSUCCESS: Registration Successful!" << endl;
-        cout << "Your User ID: " << userId << endl;
-        cout << "Please remember your credentials." << endl;
-        pauseScreen();
-    }
-    
-    void registerAdmin() {
-        clearScreen();
-        cout << "\n=====================================" << endl;
-        cout << "        ADMIN REGISTRATION          " << endl;
-        cout << "=====================================" << endl;
-        
-        string name, email, password, level;
-        
-        cin.ignore();
-        cout << "\nEnter Full Name: ";
-        getline(cin, name);
-        
-        cout << "Enter Email: ";
-        getline(cin, email);
-        while (!isValidEmail(email)) {
-            cout << "Invalid email format! Enter again: ";
-            getline(cin, email);
-        }
-        
-        cout << "Enter Password: ";
-        getline(cin, password);
-        while (password.length() < 4) {
-            cout << "Password too short! Minimum 4 characters: ";
-            getline(cin, password);
-        }
-        
-        cout << "Enter Admin Level (SUPER/REGULAR): ";
-        getline(cin, level);
-        level = toUpper(level);
-        
-        for (const auto& a : admins) {
-            if (a.getEmail() == email) {
-                cout << "\nERROR: Email already registered!" << endl;
-                pauseScreen();
-                return;
-            }
-        }
-        
-        string userId = generateId("ADM");
-        Admin newAdmin(userId, password, name, email, level);
-        admins.push_back(newAdmin);
-        saveAdmins();
-        
-        cout << "\nSUCCESS: Admin Registration Successful!" << endl;
-        cout << "Admin ID: " << userId << endl;
-        pauseScreen();
-    }
-    
-    bool loginPassenger() {
-        clearScreen();
-        cout << "\n======================================" << endl;
-        cout << "        PASSENGER LOGIN             " << endl;
-        cout << "=======================================" << endl;
-        
-        string userId, password;
-        cin.ignore();
-        cout << "\nUser ID: ";
-        getline(cin, userId);
-        cout << "Password: ";
-        getline(cin, password);
-        
-        for (auto& p : passengers) {
-            if (p.getUserId() == userId && p.getPassword() == password) {
-                currentPassenger = &p;
-                cout << "\nSUCCESS: Login Successful! Welcome, " << p.getName() << endl;
-                pauseScreen();
-                return true;
-            }
-        }
-        
-        cout << "\nERROR: Invalid credentials!" << endl;
-        pauseScreen();
-        return false;
-    }
-    
-    bool loginAdmin() {
-        clearScreen();
-        cout << "\n======================================" << endl;
-        cout << "          ADMIN LOGIN               " << endl;
-        cout << "=======================================" << endl;
-        
-        string userId, password;
-        cin.ignore();
-        cout << "\nUser ID: ";
-        getline(cin, userId);
-        cout << "Password: ";
-        getline(cin, password);
-        
-        for (auto& a : admins) {
-            if (a.getUserId() == userId && a.getPassword() == password) {
-                currentAdmin = &a;
-                cout << "\nSUCCESS: Admin Login Successful! Welcome, " << a.getName() << endl;
-                pauseScreen();
-                return true;
-            }
-        }
-        
-        cout << "\nERROR: Invalid admin credentials!" << endl;
-        pauseScreen();
-        return false;
-    }
-    
- 
-    void searchFlights() {
-        clearScreen();
-        cout << "\n======================================" << endl;
-        cout << "        SEARCH FLIGHTS              " << endl;
-        cout << "=======================================" << endl;
-        
-        string origin, destination, date;
-        cin.ignore();
-        cout << "\nOrigin City: ";
-        getline(cin, origin);
-        cout << "Destination City: ";
-        getline(cin, destination);
-        cout << "Date (DD/MM/YYYY): ";
-        getline(cin, date);
-        
-        bool found = false;
-        cout << "\n*** SEARCH RESULTS ***\n";
-        
-        for (const auto& f : flights) {
-            if (f.getOrigin() == origin && f.getDestination() == destination && 
-                f.getDepartureDate() == date && f.getAvailableSeatsCount() > 0) {
-                f.displayFlightInfo();
-                found = true;
-            }
-        }
-        
-        if (!found) {
-            cout << "\nNo flights found matching your criteria." << endl;
-        }
-        
-        pauseScreen();
-    }
-    
-    void viewAllFlights() {
-        clearScreen();
-        cout << "\n======================================" << endl;
-        cout << "       AVAILABLE FLIGHTS            " << endl;
-        cout << "===================================== " << endl;
-        
-        if (flights.empty()) {
-            cout << "\nNo flights available." << endl;
-            pauseScreen();
-            return;
-        }
-        
-        for (size_t i = 0; i < flights.size(); i++) {
-            cout << "\n" << (i + 1) << ". ";
-            flights[i].displayFlightInfo();
-        }
-        
-        pauseScreen();
-    }
-    
-    void bookFlight() {
-        if (!currentPassenger) return;
-        
-        clearScreen();
-        viewAllFlights();
-        
-        if (flights.empty()) {
-            pauseScreen();
-            return;
-        }
-        
-        cout << "\nEnter Flight Number to book: ";
-        string flightNum;
-        cin >> flightNum;
-        
-        Flight* selectedFlight = nullptr;
-        for (auto& f : flights) {
-            if (f.getFlightNumber() == flightNum) {
-                selectedFlight = &f;
-                break;
-            }
-        }
-        
-        if (!selectedFlight) {
-            cout << "\nERROR: Flight not found!" << endl;
-            pauseScreen();
-            return;
-        }
-        
-        if (selectedFlight->getAvailableSeatsCount() <= 0) {
-            cout << "\nERROR: No seats available!" << endl;
-            pauseScreen();
-            return;
-        }
-        
-        selectedFlight->displaySeatMap();
-        
-        vector<string> availableSeats = selectedFlight->getAvailableSeats();
-        cout << "\nAvailable Seats: ";
-        for (size_t i = 0; i < availableSeats.size(); i++) {
-            cout << availableSeats[i];
-            if (i < availableSeats.size() - 1) cout << ", ";
-        }
-        cout << endl;
-        
-        string seatNum;
-        cout << "\nEnter Seat Number (e.g., A1): ";
-        cin >> seatNum;
-        
-        if (!seatNum.empty()) {
-            seatNum[0] = toupper(seatNum[0]);
-        }
-        
-        if (!selectedFlight->isSeatAvailable(seatNum)) {
-            cout << "\nERROR: Seat not available!" << endl;
-            pauseScreen();
-            return;
-        }
-        
-        string bookingId = generateId("TXN");
-        double fare = selectedFlight->getBaseFare();
-        
-        Booking newBooking(bookingId, currentPassenger->getUserId(), 
-                          flightNum, seatNum, fare);
-        
-        if (selectedFlight->bookSeat(seatNum)) {
-            bookings.push_back(newBooking);
-            currentPassenger->addBooking(bookingId);
-            
-            saveBookings();
-            saveFlights();
-            savePassengers();
-            
-            cout << "\n*** BOOKING SUCCESSFUL! ***" << endl;
-            newBooking.displayBookingInfo();
-        } else {
-            cout << "\nERROR: Booking failed!" << endl;
-        }
-        
-        pauseScreen();
-    }
-    
-    void viewMyBookings() {
-        if (!currentPassenger) return;
-        
-        clearScreen();
-        cout << "\n======================================" << endl;
-        cout << "        MY BOOKINGS                 " << endl;
-        cout << "======================================" << endl;
-        
-        vector<string> myBookings = currentPassenger->getBookingIds();
-        
-        if (myBookings.empty()) {
-            cout << "\nNo bookings found." << endl;
-            pauseScreen();
-            return;
-        }
-        
-        bool found = false;
-        for (const string& bId : myBookings) {
-            for (const auto& b : bookings) {
-                if (b.getBookingId() == bId) {
-                    b.displayBookingInfo();
-                    found = true;
-                }
-            }
-        }
-        
-        if (!found) {
-            cout << "\nNo active bookings found." << endl;
-        }
-        
-        pauseScreen();
-    }
-    
-    void cancelBooking() {
-        if (!currentPassenger) return;
-        
-        clearScreen();
-        viewMyBookings();
-        
-        string bookingId;
-        cout << "\nEnter Booking ID to cancel: ";
-        cin >> bookingId;
-        
-        for (auto& b : bookings) {
-            if (b.getBookingId() == bookingId && 
-                b.getPassengerId() == currentPassenger->getUserId() &&
-                b.getStatus() == "CONFIRMED") {
-                
-                for (auto& f : flights) {
-                    if (f.getFlightNumber() == b.getFlightNumber()) {
-                        f.cancelSeat(b.getSeatNumber());
-                        break;
-                    }
-                }
-                
-                b.setStatus("CANCELLED");
-                currentPassenger->removeBooking(bookingId);
-                
-                saveBookings();
-                saveFlights();
-                savePassengers();
-                
-                cout << "\nSUCCESS: Booking Cancelled Successfully!" << endl;
-                cout << "Refund of ₹" << fixed << setprecision(2) 
-                     << b.getTotalFare() << " will be processed." << endl;
-                pauseScreen();
-                return;
-            }
-        }
-        
-        cout << "\nERROR: Booking not found or already cancelled!" << endl;
-        pauseScreen();
-    }
-    
- 
-    void addFlight() {
-        clearScreen();
-        cout << "\n=====================================" << endl;
-        cout << "          ADD NEW FLIGHT            " << endl;
-        cout << "=====================================" << endl;
-        
-        string flightNum, airline, origin, dest, date, depTime, arrTime;
-        int seats;
-        double fare;
-        
-        cin.ignore();
-        cout << "\nFlight Number: ";
-        getline(cin, flightNum);
-        cout << "Airline Name: ";
-        getline(cin, airline);
-        cout << "Origin: ";
-        getline(cin, origin);
-        cout << "Destination: ";
-        getline(cin, dest);
-        cout << "Date (DD/MM/YYYY): ";
-        getline(cin, date);
-        cout << "Departure Time (HH:MM): ";
-        getline(cin, depTime);
-        cout << "Arrival Time (HH:MM): ";
-        getline(cin, arrTime);
-        cout << "Total Seats: ";
-        cin >> seats;
-        cout << "Base Fare (₹): ";
-        cin >> fare;
-        
-        for (const auto& f : flights) {
-            if (f.getFlightNumber() == flightNum) {
-                cout << "\nERROR: Flight number already exists!" << endl;
-                pauseScreen();
-                return;
-            }
-        }
-        
-        Flight newFlight(flightNum, airline, origin, dest, date, depTime, arrTime, seats, fare);
-        flights.push_back(newFlight);
-        saveFlights();
-        
-        cout << "\nSUCCESS: Flight Added Successfully!" << endl;
-        pauseScreen();
-    }
-    
-    void removeFlight() {
-        clearScreen();
-        viewAllFlights();
-        
-        if (flights.empty()) {
-            pauseScreen();
-            return;
-        }
-        
-        string flightNum;
-        cout << "\nEnter Flight Number to remove: ";
-        cin >> flightNum;
-        
-        for (size_t i = 0; i < flights.size(); i++) {
-            if (flights[i].getFlightNumber() == flightNum) {
-                bool hasBookings = false;
-                for (const auto& b : bookings) {
-                    if (b.getFlightNumber() == flightNum && b.getStatus() == "CONFIRMED") {
-                        hasBookings = true;
-                        break;
-                    }
-                }
-                
-                if (hasBookings) {
-                    cout << "\nERROR: Cannot remove flight with active bookings!" << endl;
-                } else {
-                    flights.erase(flights.begin() + i);
-                    saveFlights();
-                    cout << "\nSUCCESS: Flight Removed Successfully!" << endl;
-                }
-                pauseScreen();
-                return;
-            }
-        }
-        
-        cout << "\nERROR: Flight not found!" << endl;
-        pauseScreen();
-    }
-    
-    void viewAllBookings() {
-        clearScreen();
-        cout << "\n======================================" << endl;
-        cout << "      ALL BOOKINGS (ADMIN)          " << endl;
-        cout << "======================================" << endl;
-        
-        if (bookings.empty()) {
-            cout << "\nNo bookings found." << endl;
-            pauseScreen();
-            return;
-        }
-        
-        int confirmed = 0, cancelled = 0;
-        double totalRevenue = 0.0;
-        
-        for (const auto& b : bookings) {
-            b.displayBookingInfo();
-            if (b.getStatus() == "CONFIRMED") {
-                confirmed++;
-                totalRevenue += b.getTotalFare();
-            } else {
-                cancelled++;
-            }
-        }
-        
-        cout << "\n========== SUMMARY ==========" << endl;
-        cout << "Total Bookings: " << bookings.size() << endl;
-        cout << "Confirmed: " << confirmed << endl;
-        cout << "Cancelled: " << cancelled << endl;
-        cout << "Total Revenue: ₹" << fixed << setprecision(2) << totalRevenue << endl;
-        cout << "=============================" << endl;
-        
-        pauseScreen();
-    }
-    
-    void viewAllPassengers() {
-        clearScreen();
-        cout << "\n=====================================" << endl;
-        cout << "     ALL PASSENGERS (ADMIN)         " << endl;
-        cout << "======================================" << endl;
-        
-        if (passengers.empty()) {
-            cout << "\nNo passengers registered." << endl;
-            pauseScreen();
-            return;
-        }
-        
-        for (size_t i = 0; i < passengers.size(); i++) {
-            cout << "\n--- Passenger " << (i + 1) << " ---" << endl;
-            passengers[i].displayInfo();
-        }
-        
-        cout << "\n\nTotal Passengers: " << passengers.size() << endl;
-        pauseScreen();
-    }
-    
-    void viewFlightOccupancy() {
-        clearScreen();
-        cout << "\n=====================================" << endl;
-        cout << "      FLIGHT OCCUPANCY REPORT       " << endl;
-        cout << "=====================================" << endl;
-
-        if (flights.empty()) {
-            cout << "\nNo flights available." << endl;
-            pauseScreen();
-            return;
-        }
-
-        for (const auto& f : flights) {
-            int booked = f.getTotalSeats() - f.getAvailableSeatsCount();
-            double occupancy = f.getTotalSeats() > 0 ? (booked * 100.0) / f.getTotalSeats() : 0.0;
-            
-            cout << "\n----------------------------------------" << endl;
-            cout << "Flight: " << f.getFlightNumber() << endl;
-            cout << "Route: " << f.getOrigin() << " -> " << f.getDestination() << endl;
-            cout << "Total Seats: " << f.getTotalSeats() << endl;
-            cout << "Booked: " << booked << endl;
-            cout << "Available: " << f.getAvailableSeatsCount() << endl;
-            cout << "Occupancy: " << fixed << setprecision(2) << occupancy << "%" << endl;
-            
-            cout << "Status: [";
-            int filled = (int)(occupancy / 5);
-            for (int i = 0; i < 20; i++) {
-                if (i < filled) cout << "#";
-                else cout << "-";
-            }
-            cout << "] " << occupancy << "%" << endl;
-        }
-        
-        pauseScreen();
-    }
-    
-    void generateReports() {
-        clearScreen();
-        cout << "\n=====================================" << endl;
-        cout << "        SYSTEM REPORTS              " << endl;
-        cout << "======================================" << endl;
-        
-        int totalFlights = flights.size();
-        int totalPassengers = passengers.size();
-        int totalBookings = bookings.size();
-        int confirmedBookings = 0;
-        int cancelledBookings = 0;
-        double totalRevenue = 0.0;
-        int totalSeats = 0;
-        int bookedSeats = 0;
-        
-        for (const auto& f : flights) {
-            totalSeats += f.getTotalSeats();
-            bookedSeats += (f.getTotalSeats() - f.getAvailableSeatsCount());
-        }
-        
-        for (const auto& b : bookings) {
-            if (b.getStatus() == "CONFIRMED") {
-                confirmedBookings++;
-                totalRevenue += b.getTotalFare();
-            } else {
-                cancelledBookings++;
-            }
-        }
-        
-        double avgBookingValue = confirmedBookings > 0 ? totalRevenue / confirmedBookings : 0.0;
-        double systemOccupancy = totalSeats > 0 ? (bookedSeats * 100.0) / totalSeats : 0.0;
-        
-        cout << "\n========== AIRLINE SYSTEM REPORT ==========" << endl;
-        cout << "\n--- FLEET STATISTICS ---" << endl;
-        cout << "Total Flights: " << totalFlights << endl;
-        cout << "Total Seat Capacity: " << totalSeats << endl;
-        cout << "Booked Seats: " << bookedSeats << endl;
-        cout << "Available Seats: " << (totalSeats - bookedSeats) << endl;
-        cout << "Overall Occupancy: " << fixed << setprecision(2) << systemOccupancy << "%" << endl;
-        
-        cout << "\n--- PASSENGER STATISTICS ---" << endl;
-        cout << "Registered Passengers: " << totalPassengers << endl;
-        cout << "Total Bookings: " << totalBookings << endl;
-        cout << "Confirmed Bookings: " << confirmedBookings << endl;
-        cout << "Cancelled Bookings: " << cancelledBookings << endl;
-        
-        cout << "\n--- FINANCIAL STATISTICS ---" << endl;
-        cout << "Total Revenue: ₹" << fixed << setprecision(2) << totalRevenue << endl;
-        cout << "Average Booking Value: ₹" << fixed << setprecision(2) << avgBookingValue << endl;
-        
-        cout << "\n--- TOP ROUTES ---" << endl;
-        map<string, int> routeFrequency;
-        for (const auto& b : bookings) {
-            if (b.getStatus() == "CONFIRMED") {
-                for (const auto& f : flights) {
-                    if (f.getFlightNumber() == b.getFlightNumber()) {
-                        string route = f.getOrigin() + " -> " + f.getDestination();
-                        routeFrequency[route]++;
-                        break;
-                    }
-                }
-            }
-        }
-        
-        if (routeFrequency.empty()) {
-            cout << "No booking data available." << endl;
-        } else {
-            vector<pair<string, int>> routes(routeFrequency.begin(), routeFrequency.end());
-            sort(routes.begin(), routes.end(), 
-                 [](const pair<string, int>& a, const pair<string, int>& b) {
-                     return a.second > b.second;
-                 });
-            
-            int rank = 1;
-            for (const auto& route : routes) {
-                cout << rank++ << ". " << route.first << " (" << route.second << " bookings)" << endl;
-                if (rank > 5) break;
-            }
-        }
-        
-        cout << "\n===========================================" << endl;
-        cout << "Report Generated on: " << getCurrentDate() << endl;
-        cout << "===========================================" << endl;
-        
-        pauseScreen();
-    }
-    
-
-    void passengerMenu() {
-        int choice;
-        do {
-            clearScreen();
-            cout << "\n=====================================" << endl;
-            cout << "      PASSENGER DASHBOARD           " << endl;
-            cout << "=====================================" << endl;
-            cout << "\nWelcome, " << currentPassenger->getName() << "!" << endl;
-            cout << "\n1. Search Flights" << endl;
-            cout << "2. View All Flights" << endl;
-            cout << "3. Book a Flight" << endl;
-            cout << "4. View My Bookings" << endl;
-            cout << "5. Cancel Booking" << endl;
-            cout << "6. My Profile" << endl;
-            cout << "7. Logout" << endl;
-            cout << "----------------------------------" << endl;
-            cout << "Enter choice: ";
-            cin >> choice;
-            
-            switch (choice) {
-                case 1:
-                    searchFlights();
-                    break;
-                case 2:
-                    viewAllFlights();
-                    break;
-                case 3:
-                    bookFlight();
-                    break;
-                case 4:
-                    viewMyBookings();
-                    break;
-                case 5:
-                    cancelBooking();
-                    break;
-                case 6:
-                    clearScreen();
-                    cout << "\n=== MY PROFILE ===" << endl;
-                    currentPassenger->displayInfo();
-                    pauseScreen();
-                    break;
-                case 7:
-                    currentPassenger = nullptr;
-                    cout << "\nLogged out successfully!" << endl;
-                    pauseScreen();
-                    break;
-                default:
-                    cout << "\nInvalid choice!" << endl;
-                    pauseScreen();
-            }
-        } while (choice != 7);
-    }
-    
-    void adminMenu() {
-        int choice;
-        do {
-            clearScreen();
-            cout << "\n=====================================" << endl;
-            cout << "       ADMIN DASHBOARD              " << endl;
-            cout << "=====================================" << endl;
-            cout << "\nWelcome, " << currentAdmin->getName() << "!" << endl;
-            cout << "\n1. Add New Flight" << endl;
-            cout << "2. Remove Flight" << endl;
-            cout << "3. View All Flights" << endl;
-            cout << "4. View All Bookings" << endl;
-            cout << "5. View All Passengers" << endl;
-            cout << "6. Flight Occupancy Report" << endl;
-            cout << "7. Generate System Reports" << endl;
-            cout << "8. Register New Admin" << endl;
-            cout << "9. Logout" << endl;
-            cout << "-------------------------------------" << endl;
-            cout << "Enter choice: ";
-            cin >> choice;
-            
-            switch (choice) {
-                case 1:
-                    addFlight();
-                    break;
-                case 2:
-                    removeFlight();
-                    break;
-                case 3:
-                    viewAllFlights();
-                    break;
-                case 4:
-                    viewAllBookings();
-                    break;
-                case 5:
-                    viewAllPassengers();
-                    break;
-                case 6:
-                    viewFlightOccupancy();
-                    break;
-                case 7:
-                    generateReports();
-                    break;
-                case 8:
-                    if (currentAdmin->getAdminLevel() == "SUPER") {
-                        registerAdmin();
-                    } else {
-                        cout << "\nERROR: Only SUPER admins can register new admins!" << endl;
-                        pauseScreen();
-                    }
-                    break;
-                case 9:
-                    currentAdmin = nullptr;
-                    cout << "\nLogged out successfully!" << endl;
-                    pauseScreen();
-                    break;
-                default:
-                    cout << "\nInvalid choice!" << endl;
-                    pauseScreen();
-            }
-        } while (choice != 9);
-    }
-    
-    void mainMenu() {
-        int choice;
-        do {
-            clearScreen();
-            cout << "\n=====================================" << endl;
-            cout << "   AIRLINE RESERVATION SYSTEM       " << endl;
-            cout << "         (Pro Level Edition)        " << endl;
-            cout << "=====================================" << endl;
-            cout << "\n1. Passenger Login" << endl;
-            cout << "2. Passenger Registration" << endl;
-            cout << "3. Admin Login" << endl;
-            cout << "4. Exit" << endl;
-            cout << "-------------------------------------" << endl;
-            cout << "Enter choice: ";
-            cin >> choice;
-            
-            switch (choice) {
-                case 1:
-                    if (loginPassenger()) {
-                        passengerMenu();
-                    }
-                    break;
-                case 2:
-                    registerPassenger();
-                    break;
-                case 3:
-                    if (loginAdmin()) {
-                        adminMenu();
-                    }
-                    break;
-                case 4:
-                    saveAllData();
-                    cout << "\nThank you for using Airline Reservation System!" << endl;
-                    cout << "Safe travels!\n" << endl;
-                    break;
-                default:
-                    cout << "\nInvalid choice! Please try again." << endl;
-                    pauseScreen();
-            }
-        } while (choice != 4);
-    }
-    
-    void run() {
-        mainMenu();
-    }
-};
-
- 
-int main() {
-    try {
-        ReservationSystem system;
-        system.run();
-    } catch (const exception& e) {
-        cerr << "\nERROR: System Error: " << e.what() << endl;
-        return 1;
-    }
-    
-    return 0;
-}
\ No newline at end of file
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <vector>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <deque>
+#include <list>
+#include <iomanip>
+#include <ctime>
+#include <sstream>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cctype>
+#include <chrono>
+#include <thread>
+#include <future>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <shared_mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <cstdio>
+#include <stdexcept>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define ARS_X86_SIMD 1
+    #include <immintrin.h>
+#endif
+
+// Instrumentation is built in unless ARS_NO_METRICS is defined, in which case
+// the ARS_TIME_SCOPE/ARS_COUNT hooks expand to nothing.
+#ifndef ARS_NO_METRICS
+    #define ARS_METRICS 1
+#endif
+
+using namespace std;
+
+ 
+static atomic<int> idCounter(1000);
+
+string generateId(const string& prefix) {
+    return prefix + to_string(idCounter++);
+}
+
+// Keeps generated IDs unique across runs by moving the counter past any loaded ID.
+void reserveId(const string& id) {
+    size_t digits = id.find_last_not_of("0123456789");
+    digits = (digits == string::npos) ? 0 : digits + 1;
+    if (digits >= id.size() || id.size() - digits > 9) return;
+    int value = 0;
+    for (size_t i = digits; i < id.size(); i++) value = value * 10 + (id[i] - '0');
+    int current = idCounter.load();
+    while (value >= current && !idCounter.compare_exchange_weak(current, value + 1)) {}
+}
+
+// The reentrant localtime: bookings on different flights are made
+// concurrently.
+string getCurrentDate() {
+    time_t now = time(0);
+    tm local;
+    #ifdef _WIN32
+        localtime_s(&local, &now);
+    #else
+        localtime_r(&now, &local);
+    #endif
+    return to_string(local.tm_mday) + "/" + 
+           to_string(1 + local.tm_mon) + "/" + 
+           to_string(1900 + local.tm_year);
+}
+
+// Dates are "D/M/YYYY" and times "HH:MM" in the text files. These convert
+// them to day numbers (days since 1 March of year 0) and minutes after
+// midnight, returning -1 for anything that does not parse.
+int parseDayNumber(string_view date) {
+    int parts[3] = {0, 0, 0};
+    int part = 0, digits = 0;
+    for (char c : date) {
+        if (c == '/') {
+            if (digits == 0 || ++part > 2) return -1;
+            digits = 0;
+        } else if (isdigit((unsigned char)c) && digits < 4) {
+            parts[part] = parts[part] * 10 + (c - '0');
+            digits++;
+        } else {
+            return -1;
+        }
+    }
+    if (part != 2 || digits == 0) return -1;
+    int d = parts[0], m = parts[1], y = parts[2];
+    if (m < 1 || m > 12 || d < 1 || d > 31) return -1;
+    y -= m <= 2;
+    int era = y / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe;
+}
+
+string formatDayNumber(int days) {
+    int era = days / 146097;
+    int doe = days - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    int d = doy - (153 * mp + 2) / 5 + 1;
+    int m = mp < 10 ? mp + 3 : mp - 9;
+    int y = yoe + era * 400 + (m <= 2);
+    return to_string(d) + "/" + to_string(m) + "/" + to_string(y);
+}
+
+int parseMinutes(string_view time) {
+    if (time.size() != 5 || time[2] != ':') return -1;
+    for (int i : {0, 1, 3, 4}) {
+        if (!isdigit((unsigned char)time[i])) return -1;
+    }
+    int h = (time[0] - '0') * 10 + (time[1] - '0');
+    int m = (time[3] - '0') * 10 + (time[4] - '0');
+    if (h > 23 || m > 59) return -1;
+    return h * 60 + m;
+}
+
+string formatMinutes(int minutes) {
+    int h = (minutes / 60) % 24, m = minutes % 60;
+    char buf[5] = {(char)('0' + h / 10), (char)('0' + h % 10), ':',
+                   (char)('0' + m / 10), (char)('0' + m % 10)};
+    return string(buf, 5);
+}
+
+// Process-wide symbol table for the strings that repeat across records:
+// cities, airlines, flight numbers, user IDs, statuses. Each distinct string
+// is stored once and named by a 32-bit ID (0 is ""). Names sit in chunks
+// that never move and an ID is only handed out once its name is in place,
+// so name() reads without a lock.
+class SymbolTable {
+private:
+    static constexpr uint32_t CHUNK_BITS = 12;
+    static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    static constexpr uint32_t MAX_CHUNKS = 1u << 16;
+
+    unique_ptr<atomic<string*>[]> chunks;
+    mutable shared_mutex lock;
+    unordered_map<string_view, uint32_t> ids;
+    uint32_t count;
+
+    SymbolTable() : chunks(new atomic<string*>[MAX_CHUNKS]), count(0) {
+        for (uint32_t i = 0; i < MAX_CHUNKS; i++) chunks[i].store(nullptr, memory_order_relaxed);
+        intern("");
+    }
+
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    static SymbolTable& instance() {
+        static SymbolTable table;
+        return table;
+    }
+
+    uint32_t intern(string_view text) {
+        // A small per-thread cache in front of the shared map lets the
+        // strings that repeat most (statuses, cities, flights) skip the lock.
+        struct Cached {
+            const string* name;
+            uint32_t id;
+        };
+        thread_local Cached cache[256] = {};
+        Cached& slot = cache[hash<string_view>()(text) & 255];
+        if (slot.name && *slot.name == text) return slot.id;
+        uint32_t id = internLocked(text);
+        slot = Cached{&name(id), id};
+        return id;
+    }
+
+    // NONE when the text was never interned.
+    uint32_t lookup(string_view text) const {
+        shared_lock<shared_mutex> guard(lock);
+        auto it = ids.find(text);
+        return it != ids.end() ? it->second : NONE;
+    }
+
+    const string& name(uint32_t id) const {
+        return chunks[id >> CHUNK_BITS].load(memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+    }
+
+    size_t size() const {
+        shared_lock<shared_mutex> guard(lock);
+        return count;
+    }
+
+private:
+    uint32_t internLocked(string_view text) {
+        {
+            shared_lock<shared_mutex> guard(lock);
+            auto it = ids.find(text);
+            if (it != ids.end()) return it->second;
+        }
+        unique_lock<shared_mutex> guard(lock);
+        auto it = ids.find(text);
+        if (it != ids.end()) return it->second;
+        if (count == CHUNK_SIZE * MAX_CHUNKS) throw runtime_error("symbol table full");
+        uint32_t id = count;
+        string* chunk = chunks[id >> CHUNK_BITS].load(memory_order_relaxed);
+        if (!chunk) {
+            chunk = new string[CHUNK_SIZE];
+            chunks[id >> CHUNK_BITS].store(chunk, memory_order_release);
+        }
+        string& name = chunk[id & (CHUNK_SIZE - 1)];
+        name.assign(text.data(), text.size());
+        ids.emplace(string_view(name), id);
+        count++;
+        return id;
+    }
+};
+
+inline uint32_t intern(string_view text) { return SymbolTable::instance().intern(text); }
+inline const string& symbolName(uint32_t id) { return SymbolTable::instance().name(id); }
+
+// Dates, times, seats and booking IDs are kept as numbers when the text
+// round-trips through the number, and as -(symbol + 1) otherwise.
+inline int32_t encodeFallback(string_view text) { return -(int32_t)intern(text) - 1; }
+inline const string& fallbackName(int32_t value) { return symbolName((uint32_t)(-(value + 1))); }
+
+// Bookings share a handful of dates, so the last one seen is remembered.
+inline int32_t encodeDate(string_view date) {
+    thread_local string lastDate;
+    thread_local int32_t lastValue = 0;
+    if (!lastDate.empty() && date == lastDate) return lastValue;
+    int days = parseDayNumber(date);
+    int32_t value = days >= 0 && formatDayNumber(days) == date ? days : encodeFallback(date);
+    lastDate.assign(date.data(), date.size());
+    lastValue = value;
+    return value;
+}
+
+inline string decodeDate(int32_t value) {
+    return value >= 0 ? formatDayNumber(value) : fallbackName(value);
+}
+
+inline int32_t encodeTime(string_view time) {
+    int minutes = parseMinutes(time);
+    return minutes >= 0 ? minutes : encodeFallback(time);
+}
+
+inline string decodeTime(int32_t value) {
+    return value >= 0 ? formatMinutes(value) : fallbackName(value);
+}
+
+// The day number or minute of an encoded value, also when its text parses
+// but is not in canonical form ("1/10/2030"). Other values are returned as
+// they are, so negative means the text does not parse.
+inline int32_t dayOf(int32_t value) {
+    if (value >= 0) return value;
+    int day = parseDayNumber(fallbackName(value));
+    return day >= 0 ? day : value;
+}
+
+inline int32_t minuteOf(int32_t value) {
+    if (value >= 0) return value;
+    int minutes = parseMinutes(fallbackName(value));
+    return minutes >= 0 ? minutes : value;
+}
+
+// Booking IDs from generateId are "TXN<n>" and are kept as n.
+inline bool parseBookingSerial(string_view id, int32_t& serial) {
+    if (id.size() < 4 || id.size() > 13 || id.compare(0, 3, "TXN") != 0) return false;
+    if (id[3] == '0' && id.size() > 4) return false;
+    int64_t n = 0;
+    for (size_t i = 3; i < id.size(); i++) {
+        if (!isdigit((unsigned char)id[i])) return false;
+        n = n * 10 + (id[i] - '0');
+        if (n > numeric_limits<int32_t>::max()) return false;
+    }
+    serial = (int32_t)n;
+    return true;
+}
+
+inline int32_t encodeBookingId(string_view id) {
+    int32_t serial;
+    return parseBookingSerial(id, serial) ? serial : encodeFallback(id);
+}
+
+// Like encodeBookingId, but fails instead of interning an unknown ID.
+inline bool lookupBookingId(string_view id, int32_t& key) {
+    if (parseBookingSerial(id, key)) return true;
+    uint32_t symbol = SymbolTable::instance().lookup(id);
+    if (symbol == SymbolTable::NONE) return false;
+    key = -(int32_t)symbol - 1;
+    return true;
+}
+
+inline string decodeBookingId(int32_t key) {
+    return key >= 0 ? "TXN" + to_string(key) : fallbackName(key);
+}
+
+// reserveId(decodeBookingId(key)) without building the string.
+inline void reserveBookingKey(int32_t key) {
+    if (key < 0) {
+        reserveId(fallbackName(key));
+        return;
+    }
+    if (key > 999999999) return;
+    int current = idCounter.load();
+    while (key >= current && !idCounter.compare_exchange_weak(current, key + 1)) {}
+}
+
+// Storage for record text that does not repeat (names, e-mails,
+// passwords). Text is copied into 64 KB blocks that are only freed with the
+// arena or by clear(), so users hold string_views and copy or destroy
+// without touching the heap. Each ReservationSystem keeps its records' text
+// in its own arena, selected for the current thread with TextArena::Use;
+// text stored outside any Use goes to a shared process-lifetime arena.
+// Each thread fills its own block; only fetching a block locks. Replaced
+// text (a changed password) stays behind in its block.
+class TextArena {
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+    static constexpr size_t CURSORS = 4;
+
+    // A thread's partly filled block, tagged with the generation of the
+    // arena it came from; generations are never reused, so a cursor into a
+    // cleared or destroyed arena simply stops matching.
+    struct Cursor {
+        uint64_t generation = 0;
+        char* next = nullptr;
+        size_t left = 0;
+    };
+
+    mutex lock;
+    vector<unique_ptr<char[]>> blocks;
+    atomic<uint64_t> generation;
+
+    static uint64_t newGeneration() {
+        static atomic<uint64_t> counter(1);
+        return counter++;
+    }
+
+    static TextArena*& selected() {
+        thread_local TextArena* arena = nullptr;
+        return arena;
+    }
+
+    char* allocate(size_t size) {
+        lock_guard<mutex> guard(lock);
+        blocks.emplace_back(new char[size]);
+        return blocks.back().get();
+    }
+
+public:
+    TextArena() : generation(newGeneration()) {}
+
+    TextArena(const TextArena&) = delete;
+    TextArena& operator=(const TextArena&) = delete;
+
+    static TextArena& shared() {
+        static TextArena arena;
+        return arena;
+    }
+
+    static TextArena& current() {
+        TextArena* arena = selected();
+        return arena ? *arena : shared();
+    }
+
+    // Makes arena the current thread's until the end of the scope.
+    class Use {
+    private:
+        TextArena* previous;
+
+    public:
+        explicit Use(TextArena& arena) : previous(selected()) { selected() = &arena; }
+        ~Use() { selected() = previous; }
+        Use(const Use&) = delete;
+        Use& operator=(const Use&) = delete;
+    };
+
+    string_view store(string_view text) {
+        // A few cursors per thread, so a thread switching between two
+        // arenas does not start a new block on every switch.
+        thread_local Cursor cursors[CURSORS];
+        thread_local size_t victim = 0;
+        if (text.empty()) return string_view();
+        if (text.size() > BLOCK_SIZE / 4) {
+            char* own = allocate(text.size());
+            memcpy(own, text.data(), text.size());
+            return string_view(own, text.size());
+        }
+        uint64_t mine = generation.load(memory_order_relaxed);
+        Cursor* cursor = nullptr;
+        for (Cursor& c : cursors) {
+            if (c.generation == mine) cursor = &c;
+        }
+        if (!cursor) {
+            cursor = &cursors[victim++ % CURSORS];
+            *cursor = Cursor();
+            cursor->generation = mine;
+        }
+        if (text.size() > cursor->left) {
+            cursor->next = allocate(BLOCK_SIZE);
+            cursor->left = BLOCK_SIZE;
+        }
+        memcpy(cursor->next, text.data(), text.size());
+        string_view stored(cursor->next, text.size());
+        cursor->next += text.size();
+        cursor->left -= text.size();
+        return stored;
+    }
+
+    // Frees every block. Nothing may still point into the arena, and no
+    // other thread may be storing into it.
+    void clear() {
+        lock_guard<mutex> guard(lock);
+        blocks.clear();
+        generation = newGeneration();
+    }
+};
+
+inline string_view storeText(string_view text) { return TextArena::current().store(text); }
+
+// Epoch-based reclamation for objects published to lock-free readers. A
+// reader pins the current epoch in its own cache line for the length of a
+// read; a writer that unpublishes an object retires it tagged with the epoch
+// into its own thread's list, and every RECLAIM_BATCH retirements advances
+// the epoch and frees what every pinned reader has moved past. Lists left by
+// exited threads are handed to whichever thread reclaims next. Threads
+// beyond READER_SLOTS share a counter that holds back all reclamation while
+// any of them reads.
+class EpochDomain {
+private:
+    static constexpr size_t READER_SLOTS = 256;
+    static constexpr size_t RECLAIM_BATCH = 64;
+    static constexpr uint64_t IDLE = numeric_limits<uint64_t>::max();
+
+    struct alignas(64) ReaderSlot {
+        atomic<uint64_t> epoch;
+        atomic<bool> claimed;
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    struct ThreadState {
+        int slot = -1;  // -1: not claimed yet, -2: overflow
+        int depth = 0;
+        vector<Retired> retired;
+        ~ThreadState() {
+            EpochDomain& domain = EpochDomain::instance();
+            if (!retired.empty()) domain.adopt(retired);
+            if (slot >= 0) domain.readers[slot].claimed.store(false, memory_order_release);
+        }
+    };
+
+    ReaderSlot readers[READER_SLOTS];
+    atomic<uint64_t> epoch;
+    atomic<int> overflowReaders;
+    mutex orphansMutex;
+    vector<Retired> orphans;
+    atomic<bool> hasOrphans;
+
+    EpochDomain() : epoch(1), overflowReaders(0), hasOrphans(false) {
+        for (auto& reader : readers) {
+            reader.epoch.store(IDLE, memory_order_relaxed);
+            reader.claimed.store(false, memory_order_relaxed);
+        }
+    }
+
+    ~EpochDomain() {
+        for (const Retired& r : orphans) r.destroy(r.object);
+    }
+
+    static ThreadState& threadState() {
+        thread_local ThreadState state;
+        return state;
+    }
+
+    int claimSlot() {
+        for (size_t i = 0; i < READER_SLOTS; i++) {
+            bool expected = false;
+            if (!readers[i].claimed.load(memory_order_relaxed) &&
+                readers[i].claimed.compare_exchange_strong(expected, true, memory_order_acquire)) {
+                return (int)i;
+            }
+        }
+        return -2;
+    }
+
+    void adopt(vector<Retired>& retired) {
+        lock_guard<mutex> guard(orphansMutex);
+        orphans.insert(orphans.end(), retired.begin(), retired.end());
+        retired.clear();
+        hasOrphans = true;
+    }
+
+    void reclaim(vector<Retired>& retired) {
+        if (overflowReaders.load() > 0) return;
+        uint64_t oldest = IDLE;
+        for (const auto& reader : readers) oldest = min(oldest, reader.epoch.load());
+        size_t kept = 0;
+        for (const Retired& r : retired) {
+            if (r.epoch < oldest) r.destroy(r.object);
+            else retired[kept++] = r;
+        }
+        retired.resize(kept);
+    }
+
+public:
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // Pins are reentrant within a thread; only the outermost one counts.
+    void enter() {
+        ThreadState& state = threadState();
+        if (state.depth++ > 0) return;
+        if (state.slot == -1) state.slot = claimSlot();
+        if (state.slot >= 0) readers[state.slot].epoch.store(epoch.load());
+        else overflowReaders.fetch_add(1);
+    }
+
+    void exit() {
+        ThreadState& state = threadState();
+        if (--state.depth > 0) return;
+        if (state.slot >= 0) readers[state.slot].epoch.store(IDLE, memory_order_release);
+        else overflowReaders.fetch_sub(1);
+    }
+
+    // Call after the object can no longer be reached from published data.
+    // Readers that pinned the tag epoch may still hold it; advancing the
+    // epoch before reclaiming keeps later readers off the tag.
+    template <typename T>
+    void retire(const T* object) {
+        if (!object) return;
+        vector<Retired>& retired = threadState().retired;
+        retired.push_back(Retired{epoch.load(), const_cast<T*>(object),
+                                  [](void* p) { delete static_cast<T*>(p); }});
+        if (retired.size() < RECLAIM_BATCH) return;
+        epoch.fetch_add(1);
+        reclaim(retired);
+        if (hasOrphans.load(memory_order_relaxed)) {
+            lock_guard<mutex> guard(orphansMutex);
+            reclaim(orphans);
+            hasOrphans = !orphans.empty();
+        }
+    }
+};
+
+class EpochGuard {
+public:
+    EpochGuard() { EpochDomain::instance().enter(); }
+    ~EpochGuard() { EpochDomain::instance().exit(); }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// ANSI clear + home instead of system("clear"), which forked a shell on
+// every screen.
+void clearScreen() {
+    cout << "\033[2J\033[H" << flush;
+}
+
+void pauseScreen() {
+    cout << "\nPress Enter to continue...";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cin.get();
+}
+
+string toUpper(const string& str) {
+    string result = str;
+    transform(result.begin(), result.end(), result.begin(), ::toupper);
+    return result;
+}
+
+bool isValidEmail(const string& email) {
+    return email.find('@') != string::npos && email.find('.') != string::npos;
+}
+
+bool isValidPhone(const string& phone) {
+    return phone.length() >= 10 && all_of(phone.begin(), phone.end(), ::isdigit);
+}
+
+// Splits a record into views over the caller's buffer; nothing is copied.
+// Fields past maxFields are dropped, matching the old token-vector behaviour.
+size_t splitFields(string_view line, char delim, string_view* out, size_t maxFields) {
+    size_t count = 0, prev = 0, pos;
+    while (count < maxFields && (pos = line.find(delim, prev)) != string_view::npos) {
+        out[count++] = line.substr(prev, pos - prev);
+        prev = pos + 1;
+    }
+    if (count < maxFields) out[count++] = line.substr(prev);
+    return count;
+}
+
+template <typename Visit>
+void forEachField(string_view list, char delim, Visit visit) {
+    size_t prev = 0, pos;
+    while ((pos = list.find(delim, prev)) != string_view::npos) {
+        visit(list.substr(prev, pos - prev));
+        prev = pos + 1;
+    }
+    if (prev < list.size()) visit(list.substr(prev));
+}
+
+int parseInt(string_view field) {
+    int value = 0;
+    from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+double parseDouble(string_view field) {
+    double value = 0.0;
+    from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+// Read-only view of a whole data file: mmap'd where available, otherwise
+// read into one buffer. Missing or empty files map to an empty view.
+class MappedFile {
+private:
+    const char* base;
+    size_t length;
+    string fallback;
+    bool mapped;
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+public:
+    explicit MappedFile(const string& path) : base(nullptr), length(0), mapped(false) {
+        #ifndef _WIN32
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size > 0) {
+                void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+                    base = static_cast<const char*>(p);
+                    length = (size_t)st.st_size;
+                    mapped = true;
+                }
+            }
+            ::close(fd);
+            if (mapped) return;
+        #endif
+        ifstream file(path, ios::binary);
+        if (file.is_open()) {
+            ostringstream contents;
+            contents << file.rdbuf();
+            fallback = contents.str();
+            base = fallback.data();
+            length = fallback.size();
+        }
+    }
+
+    ~MappedFile() {
+        #ifndef _WIN32
+            if (mapped) munmap(const_cast<char*>(base), length);
+        #endif
+    }
+
+    string_view view() const { return string_view(base, length); }
+};
+
+
+unsigned workerThreads() {
+    unsigned n = thread::hardware_concurrency();
+    return n > 0 ? n : 2;
+}
+
+// Runs work(t) for t in [0, threads) and waits for all of them.
+template <typename Work>
+void runParallel(unsigned threads, Work work) {
+    vector<future<void>> pending;
+    for (unsigned t = 1; t < threads; t++) {
+        pending.push_back(async(launch::async, work, t));
+    }
+    work(0u);
+    for (auto& f : pending) f.get();
+}
+
+
+// ---- Metrics ----
+// Every thread records into its own block of relaxed atomics (only the owner
+// writes, so updates need no locked instructions); a dump merges the blocks.
+// Latencies go into log-linear histograms in the style of HdrHistogram:
+// 16 sub-buckets per power of two, about 6% relative precision, 1 ns to
+// several hours in 656 buckets.
+enum class Timer { Book, BookBatch, Cancel, Hold, Search, SearchConnections, Login, Load, Save, Checkpoint, COUNT };
+enum class Counter { SeatsBooked, SeatsCancelled, HoldsExpired, JournalBytesWritten, JournalSyncs,
+                     JournalRecordsSynced, SnapshotBytesWritten, COUNT };
+
+inline const char* timerName(Timer timer) {
+    static const char* const names[] = {"book", "book_batch", "cancel", "hold", "search", "search_connections",
+                                        "login", "load", "save", "checkpoint"};
+    return names[(int)timer];
+}
+
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int BUCKETS = 41 * SUB_BUCKETS;
+
+    static int bucketOf(uint64_t ns) {
+        if (ns < (uint64_t)SUB_BUCKETS) return (int)ns;
+        int exponent = 63;
+        while (!(ns >> exponent)) exponent--;
+        int shift = exponent - SUB_BITS;
+        int bucket = (shift + 1) * SUB_BUCKETS + (int)((ns >> shift) & (SUB_BUCKETS - 1));
+        return min(bucket, BUCKETS - 1);
+    }
+
+    // Largest value that lands in the bucket.
+    static uint64_t upperBound(int bucket) {
+        if (bucket < SUB_BUCKETS) return (uint64_t)bucket;
+        int shift = bucket / SUB_BUCKETS - 1;
+        uint64_t mantissa = (uint64_t)(bucket % SUB_BUCKETS + SUB_BUCKETS);
+        return ((mantissa + 1) << shift) - 1;
+    }
+};
+
+#ifdef ARS_METRICS
+struct ThreadMetrics {
+    atomic<uint64_t> buckets[(int)Timer::COUNT][LatencyHistogram::BUCKETS];
+    atomic<uint64_t> sumNs[(int)Timer::COUNT];
+    atomic<uint64_t> counters[(int)Counter::COUNT];
+
+    ThreadMetrics() {
+        for (auto& timer : buckets) for (auto& b : timer) b.store(0, memory_order_relaxed);
+        for (auto& s : sumNs) s.store(0, memory_order_relaxed);
+        for (auto& c : counters) c.store(0, memory_order_relaxed);
+    }
+
+    static void bump(atomic<uint64_t>& slot, uint64_t by) {
+        slot.store(slot.load(memory_order_relaxed) + by, memory_order_relaxed);
+    }
+};
+
+// Blocks are owned by the registry and outlive their threads, so counts
+// from finished worker threads stay in the totals.
+class MetricsRegistry {
+private:
+    mutex lock;
+    vector<unique_ptr<ThreadMetrics>> blocks;
+
+public:
+    static MetricsRegistry& instance() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    ThreadMetrics& local() {
+        thread_local ThreadMetrics* mine = nullptr;
+        if (!mine) {
+            lock_guard<mutex> guard(lock);
+            blocks.emplace_back(new ThreadMetrics());
+            mine = blocks.back().get();
+        }
+        return *mine;
+    }
+
+    void merge(vector<uint64_t>& buckets, vector<uint64_t>& sums, vector<uint64_t>& counters) {
+        buckets.assign((size_t)Timer::COUNT * LatencyHistogram::BUCKETS, 0);
+        sums.assign((size_t)Timer::COUNT, 0);
+        counters.assign((size_t)Counter::COUNT, 0);
+        lock_guard<mutex> guard(lock);
+        for (const auto& block : blocks) {
+            for (int t = 0; t < (int)Timer::COUNT; t++) {
+                for (int b = 0; b < LatencyHistogram::BUCKETS; b++) {
+                    buckets[(size_t)t * LatencyHistogram::BUCKETS + b] += block->buckets[t][b].load(memory_order_relaxed);
+                }
+                sums[t] += block->sumNs[t].load(memory_order_relaxed);
+            }
+            for (int c = 0; c < (int)Counter::COUNT; c++) counters[c] += block->counters[c].load(memory_order_relaxed);
+        }
+    }
+};
+
+inline void recordLatency(Timer timer, uint64_t ns) {
+    ThreadMetrics& m = MetricsRegistry::instance().local();
+    ThreadMetrics::bump(m.buckets[(int)timer][LatencyHistogram::bucketOf(ns)], 1);
+    ThreadMetrics::bump(m.sumNs[(int)timer], ns);
+}
+
+inline void countMetric(Counter counter, uint64_t by) {
+    ThreadMetrics::bump(MetricsRegistry::instance().local().counters[(int)counter], by);
+}
+
+class ScopedTimer {
+private:
+    Timer timer;
+    chrono::steady_clock::time_point start;
+
+    ScopedTimer(const ScopedTimer&);
+    ScopedTimer& operator=(const ScopedTimer&);
+
+public:
+    explicit ScopedTimer(Timer t) : timer(t), start(chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        recordLatency(timer, (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+                                 chrono::steady_clock::now() - start).count());
+    }
+};
+
+#define ARS_CONCAT_INNER(a, b) a##b
+#define ARS_CONCAT(a, b) ARS_CONCAT_INNER(a, b)
+#define ARS_TIME_SCOPE(timer) ScopedTimer ARS_CONCAT(scopedTimer, __LINE__)(timer)
+#define ARS_COUNT(counter, by) countMetric(counter, (uint64_t)(by))
+#else
+#define ARS_TIME_SCOPE(timer) ((void)0)
+#define ARS_COUNT(counter, by) ((void)0)
+#endif
+
+// Prometheus text exposition format: one histogram family for the operation
+// latencies (cumulative le buckets at 1-2.5-5 steps from 1 us to 10 s), a
+// gauge family with p50/p99/p999 read off the fine-grained buckets, and one
+// counter per Counter.
+inline void writePrometheusMetrics(ostream& out) {
+#ifdef ARS_METRICS
+    vector<uint64_t> buckets, sums, counters;
+    MetricsRegistry::instance().merge(buckets, sums, counters);
+    const int B = LatencyHistogram::BUCKETS;
+
+    vector<double> bounds;
+    for (int exponent = -6; exponent <= 0; exponent++) {
+        for (double step : {1.0, 2.5, 5.0}) bounds.push_back(pow(10.0, exponent) * step);
+    }
+    bounds.push_back(10.0);
+
+    ostringstream text;
+    text << setprecision(9);
+    text << "# HELP ars_operation_duration_seconds Latency of reservation operations.\n";
+    text << "# TYPE ars_operation_duration_seconds histogram\n";
+    for (int t = 0; t < (int)Timer::COUNT; t++) {
+        const uint64_t* hist = &buckets[(size_t)t * B];
+        uint64_t total = 0;
+        for (int b = 0; b < B; b++) total += hist[b];
+        int b = 0;
+        uint64_t cumulative = 0;
+        for (double bound : bounds) {
+            while (b < B && LatencyHistogram::upperBound(b) <= (uint64_t)(bound * 1e9)) cumulative += hist[b++];
+            text << "ars_operation_duration_seconds_bucket{op=\"" << timerName((Timer)t) << "\",le=\""
+                 << bound << "\"} " << cumulative << "\n";
+        }
+        text << "ars_operation_duration_seconds_bucket{op=\"" << timerName((Timer)t) << "\",le=\"+Inf\"} " << total << "\n";
+        text << "ars_operation_duration_seconds_sum{op=\"" << timerName((Timer)t) << "\"} " << sums[t] / 1e9 << "\n";
+        text << "ars_operation_duration_seconds_count{op=\"" << timerName((Timer)t) << "\"} " << total << "\n";
+    }
+
+    text << "# HELP ars_operation_duration_quantile_seconds Latency percentiles (bucket upper bounds).\n";
+    text << "# TYPE ars_operation_duration_quantile_seconds gauge\n";
+    for (int t = 0; t < (int)Timer::COUNT; t++) {
+        const uint64_t* hist = &buckets[(size_t)t * B];
+        uint64_t total = 0;
+        for (int b = 0; b < B; b++) total += hist[b];
+        if (total == 0) continue;
+        for (double q : {0.5, 0.99, 0.999}) {
+            uint64_t rank = (uint64_t)ceil(q * total), seen = 0;
+            int b = 0;
+            while (b < B - 1 && (seen += hist[b]) < rank) b++;
+            text << "ars_operation_duration_quantile_seconds{op=\"" << timerName((Timer)t) << "\",quantile=\""
+                 << q << "\"} " << LatencyHistogram::upperBound(b) / 1e9 << "\n";
+        }
+    }
+
+    static const char* const counterNames[][2] = {
+        {"ars_seats_booked_total", "Seats booked."},
+        {"ars_seats_cancelled_total", "Seats released by cancellations."},
+        {"ars_holds_expired_total", "Seat holds released by their TTL."},
+        {"ars_journal_bytes_written_total", "Bytes appended to journal.log."},
+        {"ars_journal_syncs_total", "fsync calls on journal.log."},
+        {"ars_journal_records_synced_total", "Records made durable by those fsyncs."},
+        {"ars_snapshot_bytes_written_total", "Bytes written by full snapshots."}
+    };
+    for (int c = 0; c < (int)Counter::COUNT; c++) {
+        text << "# HELP " << counterNames[c][0] << " " << counterNames[c][1] << "\n";
+        text << "# TYPE " << counterNames[c][0] << " counter\n";
+        text << counterNames[c][0] << " " << counters[c] << "\n";
+    }
+    out << text.str();
+#else
+    out << "# metrics compiled out (ARS_NO_METRICS)\n";
+#endif
+}
+
+
+// Text fields point into the current TextArena at construction (see
+// adoptText()); userType is always a literal.
+class User {
+protected:
+    string_view userId;
+    string_view password;
+    string_view name;
+    string_view email;
+    string_view userType;
+
+public:
+    User() {}
+    
+    User(string_view id, string_view pass, string_view n, string_view mail, string_view type)
+        : userId(storeText(id)), password(storeText(pass)), name(storeText(n)), email(storeText(mail)),
+          userType(type) {}
+    
+    virtual ~User() {}
+    
+    virtual void displayInfo() const {
+        cout << "User ID: " << userId << endl;
+        cout << "Name: " << name << endl;
+        cout << "Email: " << email << endl;
+        cout << "Role: " << userType << endl;
+    }
+    
+    virtual string getRole() const = 0;
+    
+    string getUserId() const { return string(userId); }
+    string getPassword() const { return string(password); }
+    string getName() const { return string(name); }
+    string getEmail() const { return string(email); }
+    string getUserType() const { return string(userType); }
+    
+    void setPassword(string_view pass) { password = storeText(pass); }
+    void setName(string_view n) { name = storeText(n); }
+    void setEmail(string_view mail) { email = storeText(mail); }
+
+    // Copies the text fields into the current TextArena, for a record built
+    // elsewhere that is about to be kept.
+    void adoptText() {
+        userId = storeText(userId);
+        password = storeText(password);
+        name = storeText(name);
+        email = storeText(email);
+    }
+
+protected:
+    static string joinFields(initializer_list<string_view> fields) {
+        string line;
+        for (auto it = fields.begin(); it != fields.end(); ++it) {
+            if (it != fields.begin()) line += '|';
+            line.append(it->data(), it->size());
+        }
+        return line;
+    }
+};
+
+ 
+class Passenger : public User {
+private:
+    string_view phone;
+    string_view passportNumber;
+
+public:
+    Passenger() : User() {}
+    
+    Passenger(string_view id, string_view pass, string_view n, string_view mail, string_view ph,
+              string_view passport)
+        : User(id, pass, n, mail, "PASSENGER"), phone(storeText(ph)), passportNumber(storeText(passport)) {}
+    
+    void adoptText() {
+        User::adoptText();
+        phone = storeText(phone);
+        passportNumber = storeText(passportNumber);
+    }
+    
+    void displayInfo() const override {
+        User::displayInfo();
+        cout << "Phone: " << phone << endl;
+        cout << "Passport: " << passportNumber << endl;
+    }
+    
+    string getRole() const override { return "PASSENGER"; }
+    
+    string getPhone() const { return string(phone); }
+    string getPassportNumber() const { return string(passportNumber); }
+    // The booking list is kept by the owner's PassengerBookingIndex and only
+    // written out here; loading rebuilds it from the bookings file.
+    string toFileString(string_view bookings = string_view()) const {
+        return joinFields({userId, password, name, email, phone, passportNumber, bookings});
+    }
+    
+    static constexpr size_t FIELD_COUNT = 7;
+    
+    static Passenger fromFileString(string_view line) {
+        string_view tokens[FIELD_COUNT];
+        return fromTokens(tokens, splitFields(line, '|', tokens, FIELD_COUNT));
+    }
+    
+    static Passenger fromTokens(const string_view* tokens, size_t count) {
+        if (count < 6) return Passenger();
+        
+        return Passenger(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4], tokens[5]);
+    }
+};
+
+
+class Admin : public User {
+private:
+    string_view adminLevel;
+
+public:
+    Admin() : User() {}
+    
+    Admin(string_view id, string_view pass, string_view n, string_view mail, string_view level)
+        : User(id, pass, n, mail, "ADMIN"), adminLevel(storeText(level)) {}
+    
+    void displayInfo() const override {
+        User::displayInfo();
+        cout << "Admin Level: " << adminLevel << endl;
+    }
+    
+    string getRole() const override { return "ADMIN"; }
+    string getAdminLevel() const { return string(adminLevel); }
+    
+    string toFileString() const {
+        return joinFields({userId, password, name, email, adminLevel});
+    }
+    
+    static constexpr size_t FIELD_COUNT = 5;
+    
+    static Admin fromFileString(string_view line) {
+        string_view tokens[FIELD_COUNT];
+        return fromTokens(tokens, splitFields(line, '|', tokens, FIELD_COUNT));
+    }
+    
+    static Admin fromTokens(const string_view* tokens, size_t count) {
+        if (count < 5) return Admin();
+        
+        return Admin(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4]);
+    }
+};
+
+ 
+// Seat auto-assignment preferences. Cabins are six abreast, A-C | D-F, so
+// A/F are window seats and C/D aisle seats.
+enum class SeatPosition { Any, Window, Aisle };
+
+struct SeatPreference {
+    SeatPosition position = SeatPosition::Any;
+    bool frontRows = true;  // fill from the front of the cabin, else from the back
+    string nextTo;          // a seat to sit beside, e.g. one already booked by the group
+};
+
+
+class SeatInventory {
+private:
+    static constexpr int SEATS_PER_ROW = 6;
+    static constexpr int ROWS_PER_WORD = 8;
+
+    int totalSeats;
+    int numRows;
+    vector<uint64_t> freeBits;
+    vector<uint64_t> heldBits;
+
+    static uint64_t bitFor(int index) {
+        int row = index / SEATS_PER_ROW;
+        int col = index % SEATS_PER_ROW;
+        return uint64_t(1) << ((row % ROWS_PER_WORD) * 8 + col);
+    }
+
+    static int popcount(uint64_t word) {
+        #if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(word);
+        #else
+            int count = 0;
+            while (word) { word &= word - 1; count++; }
+            return count;
+        #endif
+    }
+
+    // Both expect a non-zero word.
+    static int lowestBit(uint64_t word) {
+        #if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(word);
+        #else
+            int bit = 0;
+            while (!(word & 1)) { word >>= 1; bit++; }
+            return bit;
+        #endif
+    }
+
+    static int highestBit(uint64_t word) {
+        #if defined(__GNUC__) || defined(__clang__)
+            return 63 - __builtin_clzll(word);
+        #else
+            int bit = 63;
+            while (!(word >> bit)) bit--;
+            return bit;
+        #endif
+    }
+
+    static int seatAt(size_t word, int bit) {
+        return ((int)word * ROWS_PER_WORD + bit / 8) * SEATS_PER_ROW + bit % 8;
+    }
+
+    // Scans the bookable-seat words from the front or back of the cabin and
+    // returns the seat of the first (or last) bit that select() leaves set.
+    template <typename Select>
+    int scanWords(bool fromFront, Select select) const {
+        size_t words = freeBits.size();
+        for (size_t k = 0; k < words; k++) {
+            size_t w = fromFront ? k : words - 1 - k;
+            uint64_t hits = select(freeBits[w] & ~heldBits[w]);
+            if (hits) return seatAt(w, fromFront ? lowestBit(hits) : highestBit(hits));
+        }
+        return -1;
+    }
+
+    // Start of the first run of count free seats inside one row. Bits 6-7 of
+    // every row byte are always clear, so a run can never spill into the next
+    // row. With exact, only gaps of exactly count seats qualify.
+    int firstRun(int count, bool fromFront, bool exact) const {
+        return scanWords(fromFront, [count, exact](uint64_t open) {
+            uint64_t run = open;
+            for (int k = 1; k < count; k++) run &= open >> k;
+            if (exact) run &= ~(open << 1) & ~(open >> count);
+            return run;
+        });
+    }
+
+public:
+    SeatInventory() : totalSeats(0), numRows(0) {}
+
+    explicit SeatInventory(int seats) { reset(seats); }
+
+    // Each row owns one byte of the bitmap (bits 0-5 = columns A-F, set = not
+    // booked), so a row never straddles a word and counts are a popcount per
+    // word. A parallel bitmap marks seats that are temporarily held.
+    void reset(int seats) {
+        totalSeats = seats > 0 ? seats : 0;
+        numRows = (totalSeats + SEATS_PER_ROW - 1) / SEATS_PER_ROW;
+        freeBits.assign((numRows + ROWS_PER_WORD - 1) / ROWS_PER_WORD, 0);
+        heldBits.assign(freeBits.size(), 0);
+        for (int i = 0; i < totalSeats; i++) {
+            freeBits[i / SEATS_PER_ROW / ROWS_PER_WORD] |= bitFor(i);
+        }
+    }
+
+    int size() const { return totalSeats; }
+    int rows() const { return numRows; }
+    static int columns() { return SEATS_PER_ROW; }
+
+    bool isValid(int index) const { return index >= 0 && index < totalSeats; }
+
+    bool isBooked(int index) const {
+        return isValid(index) &&
+               (freeBits[index / SEATS_PER_ROW / ROWS_PER_WORD] & bitFor(index)) == 0;
+    }
+
+    bool isHeld(int index) const {
+        return isValid(index) &&
+               (heldBits[index / SEATS_PER_ROW / ROWS_PER_WORD] & bitFor(index)) != 0;
+    }
+
+    bool isFree(int index) const {
+        if (!isValid(index)) return false;
+        size_t word = index / SEATS_PER_ROW / ROWS_PER_WORD;
+        return (freeBits[word] & ~heldBits[word] & bitFor(index)) != 0;
+    }
+
+    bool take(int index) {
+        if (!isFree(index)) return false;
+        freeBits[index / SEATS_PER_ROW / ROWS_PER_WORD] &= ~bitFor(index);
+        return true;
+    }
+
+    bool release(int index) {
+        if (!isBooked(index)) return false;
+        freeBits[index / SEATS_PER_ROW / ROWS_PER_WORD] |= bitFor(index);
+        return true;
+    }
+
+    bool hold(int index) {
+        if (!isFree(index)) return false;
+        heldBits[index / SEATS_PER_ROW / ROWS_PER_WORD] |= bitFor(index);
+        return true;
+    }
+
+    bool unhold(int index) {
+        if (!isHeld(index)) return false;
+        heldBits[index / SEATS_PER_ROW / ROWS_PER_WORD] &= ~bitFor(index);
+        return true;
+    }
+
+    bool takeHeld(int index) {
+        if (!isHeld(index)) return false;
+        heldBits[index / SEATS_PER_ROW / ROWS_PER_WORD] &= ~bitFor(index);
+        freeBits[index / SEATS_PER_ROW / ROWS_PER_WORD] &= ~bitFor(index);
+        return true;
+    }
+
+    int freeCount() const {
+        int count = 0;
+        for (size_t i = 0; i < freeBits.size(); i++) count += popcount(freeBits[i] & ~heldBits[i]);
+        return count;
+    }
+
+    int bookedCount() const {
+        int count = totalSeats;
+        for (uint64_t word : freeBits) count -= popcount(word);
+        return count;
+    }
+
+    int heldCount() const {
+        int count = 0;
+        for (uint64_t word : heldBits) count += popcount(word);
+        return count;
+    }
+
+    // One free seat for the preference, or -1 when the flight is full: next
+    // to preference.nextTo when possible (same row, then the rows in front
+    // and behind), else the frontmost (or rearmost) seat of the wanted
+    // position, else any seat. Cost is a few word operations per 8 rows.
+    int pick(const SeatPreference& preference) const {
+        int near = parseSeat(preference.nextTo);
+        if (isValid(near)) {
+            int row = near / SEATS_PER_ROW;
+            int col = near % SEATS_PER_ROW;
+            for (int r : {row, row + 1, row - 1}) {
+                if (r < 0 || r >= numRows) continue;
+                for (int d = 0; d < SEATS_PER_ROW; d++) {
+                    for (int c : {col - d, col + d}) {
+                        if (c >= 0 && c < SEATS_PER_ROW && isFree(r * SEATS_PER_ROW + c)) return r * SEATS_PER_ROW + c;
+                    }
+                }
+            }
+        }
+
+        const uint64_t everyRow = 0x0101010101010101ULL;
+        uint64_t columns = 0x3F * everyRow;
+        if (preference.position == SeatPosition::Window) columns = 0x21 * everyRow;
+        if (preference.position == SeatPosition::Aisle) columns = 0x0C * everyRow;
+        int seat = scanWords(preference.frontRows, [columns](uint64_t open) { return open & columns; });
+        if (seat < 0 && preference.position != SeatPosition::Any) {
+            seat = scanWords(preference.frontRows, [](uint64_t open) { return open; });
+        }
+        return seat;
+    }
+
+    // Picks count free seats for a group, preferring one unbroken run. A group
+    // that fits in a row goes into a gap of exactly its size if there is one,
+    // else the first row with room. Larger groups take the shortest run across
+    // consecutive rows that fits. Without such a run the longest runs are
+    // combined. Empty when fewer than count seats are free.
+    vector<int> findBlock(int count) const {
+        vector<int> block;
+        if (count <= 0 || count > freeCount()) return block;
+
+        if (count <= SEATS_PER_ROW) {
+            int start = firstRun(count, true, true);
+            if (start < 0) start = firstRun(count, true, false);
+            if (start >= 0) {
+                for (int k = 0; k < count; k++) block.push_back(start + k);
+                return block;
+            }
+        }
+
+        vector<pair<int, int>> runs;  // (first seat, length)
+        bool splitRows = count <= SEATS_PER_ROW;
+        int start = -1;
+        for (int i = 0; i <= totalSeats; i++) {
+            bool open = i < totalSeats && isFree(i);
+            if (start >= 0 && (!open || (splitRows && i % SEATS_PER_ROW == 0))) {
+                runs.push_back({start, i - start});
+                start = -1;
+            }
+            if (open && start < 0) start = i;
+        }
+
+        int best = -1;
+        for (int r = 0; r < (int)runs.size(); r++) {
+            if (runs[r].second >= count && (best < 0 || runs[r].second < runs[best].second)) best = r;
+        }
+        if (best >= 0) {
+            for (int k = 0; k < count; k++) block.push_back(runs[best].first + k);
+            return block;
+        }
+
+        stable_sort(runs.begin(), runs.end(),
+                    [](const pair<int, int>& a, const pair<int, int>& b) { return a.second > b.second; });
+        for (const auto& run : runs) {
+            for (int k = 0; k < run.second && (int)block.size() < count; k++) block.push_back(run.first + k);
+            if ((int)block.size() == count) break;
+        }
+        sort(block.begin(), block.end());
+        return block;
+    }
+
+    const vector<uint64_t>& words() const { return freeBits; }
+
+    // Restores a freshly reset inventory from words(); bits outside the seat
+    // range are dropped. Holds are never persisted.
+    void restoreWords(const vector<uint64_t>& saved) {
+        for (size_t i = 0; i < freeBits.size() && i < saved.size(); i++) {
+            freeBits[i] &= saved[i];
+            heldBits[i] = 0;
+        }
+    }
+
+    static size_t wordCount(int seats) {
+        int rows = (max(seats, 0) + SEATS_PER_ROW - 1) / SEATS_PER_ROW;
+        return (size_t)((rows + ROWS_PER_WORD - 1) / ROWS_PER_WORD);
+    }
+
+    static int parseSeat(string_view seat) {
+        if (seat.size() < 2) return -1;
+        char col = (char)toupper((unsigned char)seat[0]);
+        if (col < 'A' || col >= 'A' + SEATS_PER_ROW) return -1;
+        int row = 0;
+        for (size_t i = 1; i < seat.size(); i++) {
+            if (!isdigit((unsigned char)seat[i]) || row > 100000) return -1;
+            row = row * 10 + (seat[i] - '0');
+        }
+        if (row < 1) return -1;
+        return (row - 1) * SEATS_PER_ROW + (col - 'A');
+    }
+
+    static string formatSeat(int index) {
+        return string(1, (char)('A' + index % SEATS_PER_ROW)) + to_string(index / SEATS_PER_ROW + 1);
+    }
+};
+
+
+class Flight {
+    friend class BinarySnapshot;
+    
+private:
+    // Symbols, and encodeDate/encodeTime values for the schedule.
+    uint32_t flightNumber;
+    uint32_t airline;
+    uint32_t origin;
+    uint32_t destination;
+    int32_t departureDate;
+    int32_t departureTime;
+    int32_t arrivalTime;
+    int totalSeats;
+    double baseFare;
+    SeatInventory seats;
+
+public:
+    Flight() : flightNumber(0), airline(0), origin(0), destination(0), departureDate(encodeDate("")),
+               departureTime(encodeTime("")), arrivalTime(departureTime), totalSeats(0), baseFare(0.0) {}
+    
+    Flight(string_view num, string_view air, string_view org, string_view dest, string_view date,
+           string_view depTime, string_view arrTime, int seats, double fare)
+        : flightNumber(intern(num)), airline(intern(air)), origin(intern(org)), destination(intern(dest)),
+          departureDate(encodeDate(date)), departureTime(encodeTime(depTime)), arrivalTime(encodeTime(arrTime)),
+          totalSeats(seats), baseFare(fare) {
+        
+        initializeSeats();
+    }
+    
+    void initializeSeats() {
+        seats.reset(totalSeats);
+    }
+    
+    bool bookSeat(string_view seatNum) {
+        return seats.take(SeatInventory::parseSeat(seatNum));
+    }
+    
+    bool cancelSeat(string_view seatNum) {
+        return seats.release(SeatInventory::parseSeat(seatNum));
+    }
+    
+    bool isSeatAvailable(string_view seatNum) const {
+        return seats.isFree(SeatInventory::parseSeat(seatNum));
+    }
+    
+    bool holdSeat(string_view seatNum) {
+        return seats.hold(SeatInventory::parseSeat(seatNum));
+    }
+    
+    bool releaseHeldSeat(string_view seatNum) {
+        return seats.unhold(SeatInventory::parseSeat(seatNum));
+    }
+    
+    bool bookHeldSeat(string_view seatNum) {
+        return seats.takeHeld(SeatInventory::parseSeat(seatNum));
+    }
+    
+    bool bookSeatAt(int index) { return seats.take(index); }
+    bool holdSeatAt(int index) { return seats.hold(index); }
+    bool cancelSeatAt(int index) { return seats.release(index); }
+    vector<int> findSeatBlock(int count) const { return seats.findBlock(count); }
+    int pickSeat(const SeatPreference& preference) const { return seats.pick(preference); }
+    
+    vector<string> getAvailableSeats() const {
+        vector<string> available;
+        available.reserve(seats.freeCount());
+        for (int i = 0; i < seats.size(); i++) {
+            if (seats.isFree(i)) {
+                available.push_back(SeatInventory::formatSeat(i));
+            }
+        }
+        return available;
+    }
+    
+    void displayFlightInfo() const {
+        cout << "\n========================================" << endl;
+        cout << "Flight: " << symbolName(flightNumber) << " (" << symbolName(airline) << ")" << endl;
+        cout << "Route: " << symbolName(origin) << " -> " << symbolName(destination) << endl;
+        cout << "Date: " << getDepartureDate() << endl;
+        cout << "Departure: " << getDepartureTime() << " | Arrival: " << getArrivalTime() << endl;
+        cout << "Available Seats: " << getAvailableSeatsCount() << "/" << totalSeats << endl;
+        cout << "Base Fare: ₹" << fixed << setprecision(2) << baseFare << endl;
+        cout << "========================================" << endl;
+    }
+    
+    void displaySeatMap() const {
+        cout << "\n=== SEAT MAP (O = Available, X = Booked) ===" << endl;
+        cout << "     A  B  C    D  E  F" << endl;
+        
+        int cols = SeatInventory::columns();
+        for (int i = 0; i < seats.rows(); i++) {
+            cout << setw(2) << (i + 1) << "  ";
+            for (int j = 0; j < cols; j++) {
+                int index = i * cols + j;
+                if (seats.isValid(index)) {
+                    cout << " " << (seats.isFree(index) ? "O" : "X") << " ";
+                } else {
+                    cout << "   ";
+                }
+                if (j == 2) cout << "  ";
+            }
+            cout << endl;
+        }
+        cout << "=============================================" << endl;
+    }
+    
+    string getFlightNumber() const { return symbolName(flightNumber); }
+    string getAirline() const { return symbolName(airline); }
+    string getOrigin() const { return symbolName(origin); }
+    string getDestination() const { return symbolName(destination); }
+    string getDepartureDate() const { return decodeDate(departureDate); }
+    string getDepartureTime() const { return decodeTime(departureTime); }
+    string getArrivalTime() const { return decodeTime(arrivalTime); }
+    uint32_t getFlightSymbol() const { return flightNumber; }
+    uint32_t getAirlineSymbol() const { return airline; }
+    uint32_t getOriginSymbol() const { return origin; }
+    uint32_t getDestinationSymbol() const { return destination; }
+    int32_t getDepartureDay() const { return dayOf(departureDate); }
+    int32_t getDepartureMinute() const { return minuteOf(departureTime); }
+    int32_t getArrivalMinute() const { return minuteOf(arrivalTime); }
+    int getAvailableSeatsCount() const { return seats.freeCount(); }
+    int getBookedSeatsCount() const { return seats.bookedCount(); }
+    int getHeldSeatsCount() const { return seats.heldCount(); }
+    int getTotalSeats() const { return totalSeats; }
+    double getBaseFare() const { return baseFare; }
+    
+    string toFileString() const {
+        string bookedSeats = "";
+        for (int i = 0; i < seats.size(); i++) {
+            if (seats.isBooked(i)) {
+                bookedSeats += SeatInventory::formatSeat(i) + ",";
+            }
+        }
+        if (!bookedSeats.empty()) bookedSeats.pop_back();
+        
+        return getFlightNumber() + "|" + getAirline() + "|" + getOrigin() + "|" + getDestination() + "|" +
+               getDepartureDate() + "|" + getDepartureTime() + "|" + getArrivalTime() + "|" +
+               to_string(totalSeats) + "|" + to_string(getAvailableSeatsCount()) + "|" +
+               to_string(baseFare) + "|" + bookedSeats;
+    }
+    
+    static constexpr size_t FIELD_COUNT = 11;
+    
+    static Flight fromFileString(string_view line) {
+        string_view tokens[FIELD_COUNT];
+        return fromTokens(tokens, splitFields(line, '|', tokens, FIELD_COUNT));
+    }
+    
+    static Flight fromTokens(const string_view* tokens, size_t count) {
+        if (count < 10) return Flight();
+        
+        // The available count (tokens[8]) is derived from the booked seat list.
+        Flight f{tokens[0], tokens[1], tokens[2], tokens[3], tokens[4], tokens[5], tokens[6],
+                 parseInt(tokens[7]), parseDouble(tokens[9])};
+        
+        if (count > 10 && !tokens[10].empty()) {
+            forEachField(tokens[10], ',', [&f](string_view seat) {
+                f.bookSeat(seat);
+            });
+        }
+        
+        return f;
+    }
+};
+
+ 
+class Booking {
+    friend class BinarySnapshot;
+    
+private:
+    // 32 bytes: IDs are symbols or encodeBookingId/encodeDate values, the
+    // seat is its SeatInventory index (or -(symbol + 1) if not canonical).
+    int32_t bookingId;
+    uint32_t passengerId;
+    uint32_t flightNumber;
+    int32_t seatNumber;
+    int32_t bookingDate;
+    uint32_t status;
+    double totalFare;
+
+    static uint32_t confirmedSymbol() {
+        static const uint32_t symbol = intern("CONFIRMED");
+        return symbol;
+    }
+
+    static uint32_t cancelledSymbol() {
+        static const uint32_t symbol = intern("CANCELLED");
+        return symbol;
+    }
+
+    // parseSeat also accepts a lowercase column and leading zeros; only the
+    // form formatSeat prints back is kept as an index.
+    static int32_t encodeSeat(string_view seat) {
+        int index = SeatInventory::parseSeat(seat);
+        bool canonical = index >= 0 && isupper((unsigned char)seat[0]) && seat[1] != '0';
+        return canonical ? index : encodeFallback(seat);
+    }
+
+public:
+    Booking() : bookingId(encodeFallback("")), passengerId(0), flightNumber(0), seatNumber(encodeFallback("")),
+                bookingDate(encodeDate("")), status(intern("PENDING")), totalFare(0.0) {}
+    
+    Booking(string_view bId, string_view pId, string_view fNum, string_view seat, double fare)
+        : bookingId(encodeBookingId(bId)), passengerId(intern(pId)), flightNumber(intern(fNum)),
+          seatNumber(encodeSeat(seat)), bookingDate(encodeDate(getCurrentDate())),
+          status(confirmedSymbol()), totalFare(fare) {}
+    
+    void displayBookingInfo() const {
+        cout << "\n======== BOOKING DETAILS ========" << endl;
+        cout << "Booking ID: " << getBookingId() << endl;
+        cout << "Passenger ID: " << symbolName(passengerId) << endl;
+        cout << "Flight Number: " << symbolName(flightNumber) << endl;
+        cout << "Seat Number: " << getSeatNumber() << endl;
+        cout << "Booking Date: " << getBookingDate() << endl;
+        cout << "Total Fare: ₹" << fixed << setprecision(2) << totalFare << endl;
+        cout << "Status: " << symbolName(status) << endl;
+        cout << "=================================" << endl;
+    }
+    
+    string getBookingId() const { return decodeBookingId(bookingId); }
+    string getPassengerId() const { return symbolName(passengerId); }
+    string getFlightNumber() const { return symbolName(flightNumber); }
+    string getSeatNumber() const {
+        return seatNumber >= 0 ? SeatInventory::formatSeat(seatNumber) : fallbackName(seatNumber);
+    }
+    string getBookingDate() const { return decodeDate(bookingDate); }
+    string getStatus() const { return symbolName(status); }
+    double getTotalFare() const { return totalFare; }
+    
+    int32_t getBookingKey() const { return bookingId; }
+    uint32_t getPassengerSymbol() const { return passengerId; }
+    uint32_t getFlightSymbol() const { return flightNumber; }
+    // Day number of the booking date, or -1 when it is not a date.
+    int getBookingDay() const { return bookingDate >= 0 ? bookingDate : parseDayNumber(fallbackName(bookingDate)); }
+    bool isConfirmed() const { return status == confirmedSymbol(); }
+    bool isCancelled() const { return status == cancelledSymbol(); }
+    
+    void setStatus(string_view s) { status = intern(s); }
+    
+    string toFileString() const {
+        return getBookingId() + "|" + getPassengerId() + "|" + getFlightNumber() + "|" +
+               getSeatNumber() + "|" + getBookingDate() + "|" + to_string(totalFare) + "|" + getStatus();
+    }
+    
+    static constexpr size_t FIELD_COUNT = 7;
+    
+    static Booking fromFileString(string_view line) {
+        string_view tokens[FIELD_COUNT];
+        return fromTokens(tokens, splitFields(line, '|', tokens, FIELD_COUNT));
+    }
+    
+    static Booking fromTokens(const string_view* tokens, size_t count) {
+        if (count < 7) return Booking();
+        
+        Booking b;
+        b.bookingId = encodeBookingId(tokens[0]);
+        b.passengerId = intern(tokens[1]);
+        b.flightNumber = intern(tokens[2]);
+        b.seatNumber = encodeSeat(tokens[3]);
+        b.bookingDate = encodeDate(tokens[4]);
+        b.totalFare = parseDouble(tokens[5]);
+        b.status = intern(tokens[6]);
+        
+        return b;
+    }
+};
+
+
+// Crash-safe replacement of a data file. The new contents are written to
+// path + ".tmp", fsynced and renamed over path, then the directory is
+// fsynced so the rename itself is durable: after a crash the file is either
+// entirely old or entirely new, never truncated.
+inline bool syncPath(const string& path, bool directory = false) {
+    #ifdef _WIN32
+        if (directory) return true;  // NTFS logs the rename itself
+        int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+        if (fd < 0) return false;
+        bool ok = _commit(fd) == 0;
+        _close(fd);
+    #else
+        int fd = ::open(path.c_str(), O_RDONLY | (directory ? O_DIRECTORY : 0));
+        if (fd < 0) return false;
+        bool ok = fsync(fd) == 0;
+        ::close(fd);
+    #endif
+    return ok;
+}
+
+inline bool syncDirectoryOf(const string& path) {
+    size_t slash = path.find_last_of("/\\");
+    if (slash == string::npos) return syncPath(".", true);
+    return syncPath(slash == 0 ? "/" : path.substr(0, slash), true);
+}
+
+template <typename Write>
+bool replaceFile(const string& path, Write write, ios::openmode mode = ios::out) {
+    string tempPath = path + ".tmp";
+    ofstream file(tempPath, mode | ios::trunc);
+    if (!file.is_open()) return false;
+    write(file);
+    file.close();
+    error_code error;
+    if (!file || !syncPath(tempPath)) {
+        filesystem::remove(tempPath, error);
+        return false;
+    }
+    filesystem::rename(tempPath, path, error);  // replaces path atomically
+    return !error && syncDirectoryOf(path);
+}
+
+// CRC-32 (IEEE), for the binary snapshot's sections and journal lines.
+inline uint32_t crc32(const char* data, size_t length) {
+    static const vector<uint32_t> table = [] {
+        vector<uint32_t> t(256);
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+
+// Versioned binary snapshot of the whole database. Strings are interned
+// into one table and referenced by index, so all records are fixed-width.
+// Layout (little-endian):
+//   header:    "ARSB", u32 version, u32 section count, u32 directory CRC
+//   directory: per section u32 id, u32 record size, u64 count, u64 offset,
+//              u64 length, u32 CRC of the section bytes
+//   sections:  strings (u32 offsets[count + 1] + bytes), passengers, admins,
+//              flights, seat bitmaps (u64 words), bookings
+// Dates and times are day numbers and minutes. A booking (version 2) keeps
+// its ID as the TXN serial, its seat as the seat index and its status as a
+// one-byte code, so only passenger and flight IDs go through the table:
+//   i32 ID, u32 passenger, u32 flight, i32 seat, i32 date, u8 status,
+//   u24 status string (OTHER only), f64 fare
+// Values that would not round-trip to the same text are stored as
+// -(string index + 1) instead. Version 1 kept booking IDs, seats and
+// statuses as strings and is still read.
+enum class SnapshotFormat { Text, Binary };
+
+class BinarySnapshot {
+public:
+    static const uint32_t VERSION = 2;
+
+private:
+    enum SectionId : uint32_t {
+        STRINGS = 1, PASSENGERS = 2, ADMINS = 3, FLIGHTS = 4, SEATMAPS = 5, BOOKINGS = 6
+    };
+
+    enum StatusCode : uint8_t { PENDING = 0, CONFIRMED = 1, CANCELLED = 2, OTHER = 3 };
+
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t DIRECTORY_ENTRY_SIZE = 36;
+    static const uint32_t PASSENGER_RECORD = 24;
+    static const uint32_t ADMIN_RECORD = 20;
+    static const uint32_t FLIGHT_RECORD = 44;
+    static const uint32_t BOOKING_RECORD = 32;
+
+    struct Section {
+        uint32_t id;
+        uint32_t recordSize;
+        uint64_t count;
+        string bytes;
+    };
+
+    class StringTable {
+    private:
+        unordered_map<string, uint32_t> ids;
+        vector<const string*> strings;
+
+    public:
+        uint32_t intern(const string& str) {
+            auto it = ids.find(str);
+            if (it != ids.end()) return it->second;
+            uint32_t id = (uint32_t)strings.size();
+            strings.push_back(&ids.emplace(str, id).first->first);
+            return id;
+        }
+
+        Section toSection() const {
+            Section section = {STRINGS, 0, strings.size(), string()};
+            uint32_t offset = 0;
+            for (const string* str : strings) {
+                put32(section.bytes, offset);
+                offset += (uint32_t)str->size();
+            }
+            put32(section.bytes, offset);
+            for (const string* str : strings) section.bytes += *str;
+            return section;
+        }
+    };
+
+    static void put32(string& out, uint32_t v) {
+        for (int i = 0; i < 4; i++) out += (char)((v >> (8 * i)) & 0xFF);
+    }
+
+    static void put64(string& out, uint64_t v) {
+        for (int i = 0; i < 8; i++) out += (char)((v >> (8 * i)) & 0xFF);
+    }
+
+    static void putDouble(string& out, double v) {
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        put64(out, bits);
+    }
+
+    static uint32_t get32(const char* p) {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) v |= (uint32_t)(unsigned char)p[i] << (8 * i);
+        return v;
+    }
+
+    static uint64_t get64(const char* p) {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; i++) v |= (uint64_t)(unsigned char)p[i] << (8 * i);
+        return v;
+    }
+
+    static double getDouble(const char* p) {
+        uint64_t bits = get64(p);
+        double v;
+        memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    static int32_t encodeDate(const string& date, StringTable& table) {
+        int days = parseDayNumber(date);
+        if (days >= 0 && formatDayNumber(days) == date) return days;
+        return -(int32_t)table.intern(date) - 1;
+    }
+
+    static int32_t encodeTime(const string& time, StringTable& table) {
+        int minutes = parseMinutes(time);
+        if (minutes >= 0) return minutes;
+        return -(int32_t)table.intern(time) - 1;
+    }
+
+    struct Reader {
+        vector<string_view> strings;
+
+        string_view str(uint32_t id) const {
+            if (id >= strings.size()) throw runtime_error("snapshot string index out of range");
+            return strings[id];
+        }
+
+        string date(int32_t value) const {
+            return value >= 0 ? formatDayNumber(value) : string(str((uint32_t)(-(value + 1))));
+        }
+
+        string time(int32_t value) const {
+            return value >= 0 ? formatMinutes(value) : string(str((uint32_t)(-(value + 1))));
+        }
+    };
+
+public:
+    template <typename Passengers, typename Admins, typename Flights, typename Bookings>
+    static bool save(const string& path, const Passengers& passengers, const Admins& admins,
+                     const Flights& flights, const Bookings& bookings) {
+        StringTable table;
+        Section passengerSection = {PASSENGERS, PASSENGER_RECORD, passengers.size(), string()};
+        Section adminSection = {ADMINS, ADMIN_RECORD, admins.size(), string()};
+        Section flightSection = {FLIGHTS, FLIGHT_RECORD, flights.size(), string()};
+        Section seatSection = {SEATMAPS, 8, 0, string()};
+        Section bookingSection = {BOOKINGS, BOOKING_RECORD, bookings.size(), string()};
+
+        passengerSection.bytes.reserve(passengers.size() * PASSENGER_RECORD);
+        for (const auto& p : passengers) {
+            put32(passengerSection.bytes, table.intern(p.getUserId()));
+            put32(passengerSection.bytes, table.intern(p.getPassword()));
+            put32(passengerSection.bytes, table.intern(p.getName()));
+            put32(passengerSection.bytes, table.intern(p.getEmail()));
+            put32(passengerSection.bytes, table.intern(p.getPhone()));
+            put32(passengerSection.bytes, table.intern(p.getPassportNumber()));
+        }
+
+        for (const auto& a : admins) {
+            put32(adminSection.bytes, table.intern(a.getUserId()));
+            put32(adminSection.bytes, table.intern(a.getPassword()));
+            put32(adminSection.bytes, table.intern(a.getName()));
+            put32(adminSection.bytes, table.intern(a.getEmail()));
+            put32(adminSection.bytes, table.intern(a.getAdminLevel()));
+        }
+
+        for (const auto& f : flights) {
+            string& out = flightSection.bytes;
+            put32(out, table.intern(f.getFlightNumber()));
+            put32(out, table.intern(f.getAirline()));
+            put32(out, table.intern(f.getOrigin()));
+            put32(out, table.intern(f.getDestination()));
+            put32(out, (uint32_t)encodeDate(f.getDepartureDate(), table));
+            put32(out, (uint32_t)encodeTime(f.getDepartureTime(), table));
+            put32(out, (uint32_t)encodeTime(f.getArrivalTime(), table));
+            put32(out, (uint32_t)f.totalSeats);
+            putDouble(out, f.baseFare);
+            put32(out, (uint32_t)seatSection.count);
+            for (uint64_t word : f.seats.words()) {
+                put64(seatSection.bytes, word);
+                seatSection.count++;
+            }
+        }
+
+        bookingSection.bytes.reserve(bookings.size() * BOOKING_RECORD);
+        static const uint32_t pendingSymbol = intern("PENDING");
+        for (const auto& b : bookings) {
+            string& out = bookingSection.bytes;
+            put32(out, (uint32_t)(b.bookingId >= 0 ? b.bookingId : -(int32_t)table.intern(b.getBookingId()) - 1));
+            put32(out, table.intern(b.getPassengerId()));
+            put32(out, table.intern(b.getFlightNumber()));
+            put32(out, (uint32_t)(b.seatNumber >= 0 ? b.seatNumber : -(int32_t)table.intern(b.getSeatNumber()) - 1));
+            put32(out, (uint32_t)(b.bookingDate >= 0 ? b.bookingDate : encodeDate(b.getBookingDate(), table)));
+            uint32_t status = PENDING;
+            if (b.isConfirmed()) status = CONFIRMED;
+            else if (b.isCancelled()) status = CANCELLED;
+            else if (b.status != pendingSymbol) {
+                uint32_t text = table.intern(b.getStatus());
+                if (text > 0xFFFFFF) return false;
+                status = OTHER | text << 8;
+            }
+            put32(out, status);
+            putDouble(out, b.totalFare);
+        }
+
+        Section sections[] = {table.toSection(), passengerSection, adminSection,
+                              flightSection, seatSection, bookingSection};
+        const uint32_t sectionCount = sizeof(sections) / sizeof(sections[0]);
+
+        string directory;
+        uint64_t offset = HEADER_SIZE + sectionCount * DIRECTORY_ENTRY_SIZE;
+        for (const auto& section : sections) {
+            put32(directory, section.id);
+            put32(directory, section.recordSize);
+            put64(directory, section.count);
+            put64(directory, offset);
+            put64(directory, section.bytes.size());
+            put32(directory, crc32(section.bytes.data(), section.bytes.size()));
+            offset += section.bytes.size();
+        }
+
+        string header = "ARSB";
+        put32(header, VERSION);
+        put32(header, sectionCount);
+        put32(header, crc32(directory.data(), directory.size()));
+
+        bool saved = replaceFile(path, [&](ofstream& file) {
+            file.write(header.data(), header.size());
+            file.write(directory.data(), directory.size());
+            for (const auto& section : sections) {
+                file.write(section.bytes.data(), section.bytes.size());
+            }
+        }, ios::binary);
+        if (saved) ARS_COUNT(Counter::SnapshotBytesWritten, offset);
+        return saved;
+    }
+
+    // Decodes a snapshot into record vectors; throws runtime_error when the
+    // file is truncated, from a newer schema, or fails a checksum.
+    static void load(const string& path, vector<Passenger>& passengers, vector<Admin>& admins,
+                     vector<Flight>& flights, vector<Booking>& bookings, unsigned threads) {
+        MappedFile file(path);
+        string_view data = file.view();
+        if (data.size() < HEADER_SIZE || data.substr(0, 4) != "ARSB") {
+            throw runtime_error(path + ": not a binary snapshot");
+        }
+        uint32_t version = get32(data.data() + 4);
+        if (version > VERSION) {
+            throw runtime_error(path + ": unsupported snapshot version " + to_string(version));
+        }
+        uint32_t sectionCount = get32(data.data() + 8);
+        size_t directorySize = (size_t)sectionCount * DIRECTORY_ENTRY_SIZE;
+        if (data.size() < HEADER_SIZE + directorySize ||
+            crc32(data.data() + HEADER_SIZE, directorySize) != get32(data.data() + 12)) {
+            throw runtime_error(path + ": corrupt section directory");
+        }
+
+        map<uint32_t, pair<uint64_t, string_view>> found;
+        for (uint32_t i = 0; i < sectionCount; i++) {
+            const char* entry = data.data() + HEADER_SIZE + i * DIRECTORY_ENTRY_SIZE;
+            uint32_t id = get32(entry);
+            uint32_t recordSize = get32(entry + 4);
+            uint64_t count = get64(entry + 8);
+            uint64_t offset = get64(entry + 16);
+            uint64_t length = get64(entry + 24);
+            if (offset > data.size() || length > data.size() - offset ||
+                (recordSize != 0 && count * recordSize != length)) {
+                throw runtime_error(path + ": section " + to_string(id) + " is truncated");
+            }
+            string_view bytes = data.substr((size_t)offset, (size_t)length);
+            if (crc32(bytes.data(), bytes.size()) != get32(entry + 32)) {
+                throw runtime_error(path + ": checksum mismatch in section " + to_string(id));
+            }
+            found[id] = make_pair(count, bytes);
+        }
+        for (uint32_t id : {STRINGS, PASSENGERS, ADMINS, FLIGHTS, SEATMAPS, BOOKINGS}) {
+            if (!found.count(id)) throw runtime_error(path + ": missing section " + to_string(id));
+        }
+
+        Reader reader;
+        uint64_t stringCount = found[STRINGS].first;
+        string_view strings = found[STRINGS].second;
+        if ((stringCount + 1) * 4 > strings.size()) throw runtime_error(path + ": bad string table");
+        string_view blob = strings.substr((size_t)(stringCount + 1) * 4);
+        reader.strings.reserve((size_t)stringCount);
+        for (uint64_t i = 0; i < stringCount; i++) {
+            uint32_t begin = get32(strings.data() + i * 4);
+            uint32_t end = get32(strings.data() + (i + 1) * 4);
+            if (begin > end || end > blob.size()) throw runtime_error(path + ": bad string table");
+            reader.strings.push_back(blob.substr(begin, end - begin));
+        }
+
+        string_view section = found[PASSENGERS].second;
+        for (size_t i = 0; i < found[PASSENGERS].first; i++) {
+            const char* r = section.data() + i * PASSENGER_RECORD;
+            string_view tokens[6];
+            for (int k = 0; k < 6; k++) tokens[k] = reader.str(get32(r + 4 * k));
+            passengers.push_back(Passenger::fromTokens(tokens, 6));
+        }
+
+        section = found[ADMINS].second;
+        for (size_t i = 0; i < found[ADMINS].first; i++) {
+            const char* r = section.data() + i * ADMIN_RECORD;
+            string_view tokens[5];
+            for (int k = 0; k < 5; k++) tokens[k] = reader.str(get32(r + 4 * k));
+            admins.push_back(Admin::fromTokens(tokens, 5));
+        }
+
+        string_view seatWords = found[SEATMAPS].second;
+        uint64_t seatWordCount = found[SEATMAPS].first;
+        section = found[FLIGHTS].second;
+        for (size_t i = 0; i < found[FLIGHTS].first; i++) {
+            const char* r = section.data() + i * FLIGHT_RECORD;
+            int seats = (int)get32(r + 28);
+            Flight f(reader.str(get32(r)), reader.str(get32(r + 4)), reader.str(get32(r + 8)),
+                     reader.str(get32(r + 12)), reader.date((int32_t)get32(r + 16)),
+                     reader.time((int32_t)get32(r + 20)), reader.time((int32_t)get32(r + 24)),
+                     seats, getDouble(r + 32));
+            uint64_t first = get32(r + 40);
+            vector<uint64_t> words(SeatInventory::wordCount(seats));
+            if (first + words.size() > seatWordCount) throw runtime_error(path + ": bad seat bitmap");
+            for (size_t w = 0; w < words.size(); w++) {
+                words[w] = get64(seatWords.data() + (first + w) * 8);
+            }
+            f.seats.restoreWords(words);
+            flights.push_back(move(f));
+        }
+
+        section = found[BOOKINGS].second;
+        size_t bookingCount = (size_t)found[BOOKINGS].first;
+        size_t base = bookings.size();
+        bookings.resize(base + bookingCount);
+        threads = (unsigned)min<size_t>(max(threads, 1u), bookingCount / 65536 + 1);
+        runParallel(threads, [&](unsigned t) {
+            for (size_t i = bookingCount * t / threads; i < bookingCount * (t + 1) / threads; i++) {
+                const char* r = section.data() + i * BOOKING_RECORD;
+                Booking& b = bookings[base + i];
+                b.passengerId = intern(reader.str(get32(r + 4)));
+                b.flightNumber = intern(reader.str(get32(r + 8)));
+                b.bookingDate = ::encodeDate(reader.date((int32_t)get32(r + 16)));
+                b.totalFare = getDouble(r + 24);
+                if (version == 1) {
+                    b.bookingId = encodeBookingId(reader.str(get32(r)));
+                    b.seatNumber = Booking::encodeSeat(reader.str(get32(r + 12)));
+                    b.status = intern(reader.str(get32(r + 20)));
+                    continue;
+                }
+                int32_t id = (int32_t)get32(r);
+                b.bookingId = id >= 0 ? id : encodeBookingId(reader.str((uint32_t)(-(id + 1))));
+                int32_t seat = (int32_t)get32(r + 12);
+                b.seatNumber = seat >= 0 ? seat : Booking::encodeSeat(reader.str((uint32_t)(-(seat + 1))));
+                uint32_t status = get32(r + 20);
+                switch (status & 0xFF) {
+                    case PENDING: b.status = intern("PENDING"); break;
+                    case CONFIRMED: b.status = Booking::confirmedSymbol(); break;
+                    case CANCELLED: b.status = Booking::cancelledSymbol(); break;
+                    default: b.status = intern(reader.str(status >> 8)); break;
+                }
+            }
+        });
+    }
+};
+
+
+// Append-only record storage in slabs of 4096 that are allocated whole and
+// never move, so a record's handle (its insertion index) and its address
+// stay valid for the arena's lifetime. One writer at a time; readers may
+// use any handle they were given while records are being added. Records
+// with trivial destructors are released a slab at a time without a visit.
+template <typename T>
+class RecordArena {
+private:
+    static constexpr uint32_t SLAB_BITS = 12;
+    static constexpr uint32_t SLAB_SIZE = 1u << SLAB_BITS;
+    static constexpr uint32_t MAX_SLABS = 1u << 16;
+
+    unique_ptr<atomic<T*>[]> slabs;
+    size_t count;
+
+    T* slab(size_t index) const { return slabs[index].load(memory_order_acquire); }
+
+    T* slot(size_t handle) {
+        T* current = slabs[handle >> SLAB_BITS].load(memory_order_relaxed);
+        if (!current) {
+            current = static_cast<T*>(::operator new(sizeof(T) * SLAB_SIZE));
+            slabs[handle >> SLAB_BITS].store(current, memory_order_release);
+        }
+        return current + (handle & (SLAB_SIZE - 1));
+    }
+
+public:
+    typedef uint32_t Handle;
+
+    template <typename Ref, typename Arena>
+    class Iterator {
+    private:
+        Arena* arena;
+        size_t handle;
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef typename remove_reference<Ref>::type* pointer;
+        typedef Ref reference;
+
+        Iterator(Arena* owner, size_t at) : arena(owner), handle(at) {}
+        Ref operator*() const { return (*arena)[(Handle)handle]; }
+        pointer operator->() const { return &(*arena)[(Handle)handle]; }
+        Iterator& operator++() { handle++; return *this; }
+        Iterator operator++(int) { Iterator before = *this; handle++; return before; }
+        bool operator==(const Iterator& other) const { return handle == other.handle; }
+        bool operator!=(const Iterator& other) const { return handle != other.handle; }
+    };
+
+    typedef Iterator<T&, RecordArena> iterator;
+    typedef Iterator<const T&, const RecordArena> const_iterator;
+
+    RecordArena() : slabs(new atomic<T*>[MAX_SLABS]), count(0) {
+        for (uint32_t i = 0; i < MAX_SLABS; i++) slabs[i].store(nullptr, memory_order_relaxed);
+    }
+
+    RecordArena(const RecordArena&) = delete;
+    RecordArena& operator=(const RecordArena&) = delete;
+
+    ~RecordArena() { clear(); }
+
+    Handle push_back(T record) {
+        if (count == (size_t)SLAB_SIZE * MAX_SLABS) throw runtime_error("record arena full");
+        new (slot(count)) T(move(record));
+        return (Handle)count++;
+    }
+
+    T& operator[](Handle handle) { return slab(handle >> SLAB_BITS)[handle & (SLAB_SIZE - 1)]; }
+    const T& operator[](Handle handle) const { return slab(handle >> SLAB_BITS)[handle & (SLAB_SIZE - 1)]; }
+
+    T& back() { return (*this)[(Handle)(count - 1)]; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+    // The first n records, which stay put while more are added.
+    class Prefix {
+    private:
+        const RecordArena* arena;
+        size_t n;
+
+    public:
+        Prefix(const RecordArena* owner, size_t length) : arena(owner), n(length) {}
+        size_t size() const { return n; }
+        const_iterator begin() const { return const_iterator(arena, 0); }
+        const_iterator end() const { return const_iterator(arena, n); }
+    };
+
+    Prefix prefix(size_t n) const { return Prefix(this, n); }
+
+    void clear() {
+        if (!is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < count; i++) (*this)[(Handle)i].~T();
+        }
+        for (size_t i = 0; i < ((count + SLAB_SIZE - 1) >> SLAB_BITS); i++) {
+            ::operator delete(slabs[i].load(memory_order_relaxed));
+            slabs[i].store(nullptr, memory_order_relaxed);
+        }
+        count = 0;
+    }
+};
+
+
+// Open-addressing map from integer keys to small values, for indexes that
+// would otherwise allocate a hash node per key. The two lowest key values
+// are reserved as empty/erased markers. Slots move when the table grows, so
+// found entries are only valid until the next insert.
+template <typename Key, typename Value>
+class FlatIntMap {
+private:
+    static constexpr Key EMPTY = numeric_limits<Key>::min();
+    static constexpr Key ERASED = numeric_limits<Key>::min() + 1;
+
+    vector<pair<Key, Value>> slots;
+    size_t live;
+    size_t used;  // live + erased
+
+    static uint32_t mix(Key key) {
+        uint32_t h = (uint32_t)key;
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        return h ^ (h >> 16);
+    }
+
+    void rehash(size_t capacity) {
+        vector<pair<Key, Value>> old(capacity, make_pair(EMPTY, Value()));
+        old.swap(slots);
+        used = live;
+        size_t mask = slots.size() - 1;
+        for (const auto& entry : old) {
+            if (entry.first == EMPTY || entry.first == ERASED) continue;
+            size_t i = mix(entry.first) & mask;
+            while (slots[i].first != EMPTY) i = (i + 1) & mask;
+            slots[i] = entry;
+        }
+    }
+
+public:
+    typedef pair<Key, Value>* iterator;
+
+    FlatIntMap() : live(0), used(0) {}
+
+    iterator end() { return nullptr; }
+
+    iterator find(Key key) {
+        if (slots.empty()) return end();
+        size_t mask = slots.size() - 1;
+        for (size_t i = mix(key) & mask; slots[i].first != EMPTY; i = (i + 1) & mask) {
+            if (slots[i].first == key) return &slots[i];
+        }
+        return end();
+    }
+
+    Value& operator[](Key key) {
+        iterator found = find(key);
+        if (found) return found->second;
+        if ((used + 1) * 4 > slots.size() * 3) rehash(max<size_t>(16, slots.size() * (live * 2 >= slots.size() ? 2 : 1)));
+        size_t mask = slots.size() - 1;
+        size_t i = mix(key) & mask;
+        while (slots[i].first != EMPTY && slots[i].first != ERASED) i = (i + 1) & mask;
+        if (slots[i].first == EMPTY) used++;
+        live++;
+        slots[i] = make_pair(key, Value());
+        return slots[i].second;
+    }
+
+    size_t erase(Key key) {
+        iterator found = find(key);
+        if (!found) return 0;
+        found->first = ERASED;
+        live--;
+        return 1;
+    }
+
+    void reserve(size_t n) {
+        size_t capacity = 16;
+        while (capacity * 3 < n * 4) capacity *= 2;
+        if (capacity > slots.size()) rehash(capacity);
+    }
+
+    size_t size() const { return live; }
+
+    void clear() {
+        slots.clear();
+        live = 0;
+        used = 0;
+    }
+};
+
+
+// Hash index split into independent partitions by the high bits of the key
+// hash, so a bulk load can fill the partitions from separate threads. The
+// hash is mixed first because integer keys hash to themselves. Map may be a
+// FlatIntMap, whose entries move on insert; read those through get().
+template <typename Value, typename Key = string, typename Map = unordered_map<Key, Value>>
+class PartitionedIndex {
+private:
+    static constexpr size_t PARTITIONS = 16;
+    Map parts[PARTITIONS];
+    mutable mutex locks[PARTITIONS];
+
+public:
+    static size_t partitionOf(const Key& key) {
+        return (size_t)(((uint64_t)hash<Key>()(key) * 0x9E3779B97F4A7C15ULL) >> 60) % PARTITIONS;
+    }
+
+    // Lookups and updates lock only the key's partition. Returned pointers stay
+    // valid until that key is erased (map nodes never move).
+    Value* find(const Key& key) {
+        size_t p = partitionOf(key);
+        lock_guard<mutex> lock(locks[p]);
+        auto it = parts[p].find(key);
+        return it != parts[p].end() ? &it->second : nullptr;
+    }
+
+    bool get(const Key& key, Value& value) {
+        size_t p = partitionOf(key);
+        lock_guard<mutex> lock(locks[p]);
+        auto it = parts[p].find(key);
+        if (it == parts[p].end()) return false;
+        value = it->second;
+        return true;
+    }
+
+    void set(const Key& key, Value value) {
+        size_t p = partitionOf(key);
+        lock_guard<mutex> lock(locks[p]);
+        parts[p][key] = value;
+    }
+
+    bool erase(const Key& key) {
+        size_t p = partitionOf(key);
+        lock_guard<mutex> lock(locks[p]);
+        return parts[p].erase(key) > 0;
+    }
+
+    void clear() {
+        for (auto& part : parts) part.clear();
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& part : parts) total += part.size();
+        return total;
+    }
+
+    // Indexes records[from..] as value(record, position) using one thread per
+    // group of partitions; each thread scans everything but only inserts keys
+    // it owns. Not safe against concurrent find/set; used only while loading.
+    template <typename Records, typename KeyOf, typename Val>
+    void bulkInsert(Records& records, size_t from, KeyOf key, Val value, unsigned threads) {
+        size_t expected = (records.size() - from) / PARTITIONS + 1;
+        threads = (unsigned)min<size_t>(max(threads, 1u), PARTITIONS);
+        runParallel(threads, [&](unsigned t) {
+            for (size_t p = t; p < PARTITIONS; p += threads) parts[p].reserve(parts[p].size() + expected);
+            for (size_t i = from; i < records.size(); i++) {
+                const auto& k = key(records[i]);
+                size_t p = partitionOf(k);
+                if (p % threads == t) parts[p][k] = value(records[i], i);
+            }
+        });
+    }
+};
+
+
+// Read side of the flight catalog, for searches that never lock. Each live
+// flight has a FlightSlot holding its latest immutable copy, replaced under
+// the flight's lock on every seat change. A FlightCatalog is an immutable
+// set of slots by number and by route, replaced only when flights are added
+// or removed. Readers hold an EpochGuard while they use either; replaced
+// copies, slots and catalogs go to EpochDomain::retire.
+struct FlightSlot {
+    atomic<const Flight*> view;
+
+    explicit FlightSlot(const Flight& f) : view(new Flight(f)) {}
+    ~FlightSlot() { delete view.load(memory_order_relaxed); }
+};
+
+// A route on a day, by interned city. Dates are compared as day numbers;
+// ones that do not parse by their symbol, as -(symbol + 1).
+struct RouteKey {
+    uint32_t origin;
+    uint32_t destination;
+    int32_t day;
+
+    bool operator==(const RouteKey& other) const {
+        return origin == other.origin && destination == other.destination && day == other.day;
+    }
+};
+
+struct RouteKeyHash {
+    size_t operator()(const RouteKey& key) const {
+        uint64_t h = ((uint64_t)key.origin << 32 | key.destination) * 0x9E3779B97F4A7C15ull;
+        return (size_t)(h ^ (h >> 29) ^ (uint32_t)key.day);
+    }
+};
+
+// A route on any day, for report totals: origin symbol << 32 | destination.
+inline uint64_t cityPairOf(const Flight& f) {
+    return (uint64_t)f.getOriginSymbol() << 32 | f.getDestinationSymbol();
+}
+
+inline string cityPairName(uint64_t pair) {
+    return symbolName((uint32_t)(pair >> 32)) + " -> " + symbolName((uint32_t)pair);
+}
+
+struct FlightCatalog {
+    typedef vector<const FlightSlot*> Route;
+
+    vector<const FlightSlot*> all;  // catalog order
+    unordered_map<uint32_t, const FlightSlot*> byNumber;  // by flight symbol
+    // In departure-time order. Catalogs share the lists of routes that did
+    // not change between them.
+    unordered_map<RouteKey, shared_ptr<const Route>, RouteKeyHash> byRoute;
+
+    static RouteKey routeOf(const Flight& f) {
+        return RouteKey{f.getOriginSymbol(), f.getDestinationSymbol(), f.getDepartureDay()};
+    }
+
+    // False when no flight can be on the route: a city or an unparsed date
+    // that was never interned. Looks symbols up without adding them.
+    static bool findRoute(string_view origin, string_view destination, string_view date, RouteKey& key) {
+        const SymbolTable& symbols = SymbolTable::instance();
+        key.origin = symbols.lookup(origin);
+        key.destination = symbols.lookup(destination);
+        int day = parseDayNumber(date);
+        uint32_t dateSymbol = day >= 0 ? 0 : symbols.lookup(date);
+        key.day = day >= 0 ? day : -(int32_t)dateSymbol - 1;
+        return key.origin != SymbolTable::NONE && key.destination != SymbolTable::NONE &&
+               dateSymbol != SymbolTable::NONE;
+    }
+};
+
+
+enum class ItinerarySort { EarliestArrival, LowestFare };
+
+struct Itinerary {
+    vector<Flight> legs;
+    int departure;      // minutes since day 0 of the day-number calendar
+    int arrival;
+    double totalFare;
+};
+
+// The schedule as a time-expanded graph: every flight is an edge from
+// (origin, departure) to (destination, arrival), and each city's departures
+// are kept sorted by absolute departure minute so the onward legs of a
+// connection are one binary search away. Cities are their interned
+// symbols. Maintained under the catalog's exclusive lock and searched under
+// a shared one.
+class FlightGraph {
+private:
+    struct Leg {
+        int departs;
+        int arrives;
+        uint32_t destination;
+        double fare;
+        const Flight* flight;
+        bool operator<(const Leg& other) const { return departs < other.departs; }
+    };
+
+    struct SearchState {
+        uint32_t target;
+        int minConnection;
+        int maxLayover;
+        size_t maxLegs;
+        size_t topK;
+        ItinerarySort sortBy;
+        uint32_t origin;
+        vector<const Leg*> path;
+        vector<pair<double, vector<const Leg*>>> best;
+
+        // Paths are at most maxLegs long, so a scan beats a per-city table.
+        bool visited(uint32_t city) const {
+            if (city == origin) return true;
+            for (const Leg* leg : path) {
+                if (leg->destination == city) return true;
+            }
+            return false;
+        }
+    };
+
+    unordered_map<uint32_t, vector<Leg>> departures;
+
+    // Legs are placed on the absolute minute timeline; an arrival earlier
+    // than the departure is taken to land the next day.
+    static bool legOf(const Flight& f, Leg& leg) {
+        int day = f.getDepartureDay();
+        int dep = f.getDepartureMinute();
+        int arr = f.getArrivalMinute();
+        if (day < 0 || dep < 0 || arr < 0) return false;
+        leg.departs = day * 1440 + dep;
+        leg.arrives = day * 1440 + arr + (arr < dep ? 1440 : 0);
+        leg.destination = f.getDestinationSymbol();
+        leg.fare = f.getBaseFare();
+        leg.flight = &f;
+        return true;
+    }
+
+    static double metric(const SearchState& st, int arrival, double fare) {
+        return st.sortBy == ItinerarySort::EarliestArrival ? arrival : fare;
+    }
+
+    // Once topK itineraries are known, any partial path whose arrival (or
+    // fare) is already no better than the worst of them is abandoned: both
+    // only grow as legs are added.
+    template <typename IsOpen>
+    void extend(SearchState& st, uint32_t city, int readyAt, int latest, double fare, IsOpen& isOpen) const {
+        auto found = departures.find(city);
+        if (found == departures.end()) return;
+        const vector<Leg>& out = found->second;
+        Leg probe;
+        probe.departs = readyAt;
+        for (auto it = lower_bound(out.begin(), out.end(), probe); it != out.end() && it->departs <= latest; ++it) {
+            const Leg& leg = *it;
+            if (st.visited(leg.destination)) continue;
+            double cost = fare + leg.fare;
+            double value = metric(st, leg.arrives, cost);
+            if (st.best.size() == st.topK && value >= st.best.back().first) continue;
+            if (leg.destination != st.target && st.path.size() + 1 >= st.maxLegs) continue;
+            if (!isOpen(leg.flight)) continue;
+
+            st.path.push_back(&leg);
+            if (leg.destination == st.target) {
+                auto pos = upper_bound(st.best.begin(), st.best.end(), value,
+                                       [](double v, const pair<double, vector<const Leg*>>& e) { return v < e.first; });
+                st.best.insert(pos, make_pair(value, st.path));
+                if (st.best.size() > st.topK) st.best.pop_back();
+            } else {
+                extend(st, leg.destination, leg.arrives + st.minConnection,
+                       leg.arrives + st.maxLayover, cost, isOpen);
+            }
+            st.path.pop_back();
+        }
+    }
+
+public:
+    struct Path {
+        vector<const Flight*> flights;
+        int departure;
+        int arrival;
+    };
+
+    void insert(const Flight* f) {
+        Leg leg;
+        if (!legOf(*f, leg)) return;
+        vector<Leg>& out = departures[f->getOriginSymbol()];
+        out.insert(upper_bound(out.begin(), out.end(), leg), leg);
+    }
+
+    void erase(const Flight* f) {
+        auto found = departures.find(f->getOriginSymbol());
+        if (found == departures.end()) return;
+        vector<Leg>& out = found->second;
+        for (auto it = out.begin(); it != out.end(); ++it) {
+            if (it->flight == f) {
+                out.erase(it);
+                if (out.empty()) departures.erase(found);
+                return;
+            }
+        }
+    }
+
+    void clear() {
+        departures.clear();
+    }
+
+    // Itineraries leave origin on the given day and change planes with at
+    // least minConnection and at most maxLayover minutes on the ground,
+    // never revisiting a city. isOpen(flight) filters out full flights.
+    template <typename IsOpen>
+    vector<Path> search(const string& origin, const string& destination, const string& date,
+                        size_t maxLegs, int minConnection, int maxLayover,
+                        size_t topK, ItinerarySort sortBy, IsOpen isOpen) const {
+        vector<Path> result;
+        const SymbolTable& symbols = SymbolTable::instance();
+        uint32_t from = symbols.lookup(origin);
+        uint32_t to = symbols.lookup(destination);
+        int day = parseDayNumber(date);
+        if (from == SymbolTable::NONE || to == SymbolTable::NONE || from == to || day < 0 ||
+            topK == 0 || maxLegs == 0) {
+            return result;
+        }
+
+        SearchState st;
+        st.target = to;
+        st.minConnection = minConnection;
+        st.maxLayover = maxLayover;
+        st.maxLegs = maxLegs;
+        st.topK = topK;
+        st.sortBy = sortBy;
+        st.origin = from;
+        extend(st, from, day * 1440, day * 1440 + 1439, 0.0, isOpen);
+
+        for (const auto& entry : st.best) {
+            Path path = {{}, entry.second.front()->departs, entry.second.back()->arrives};
+            for (const Leg* leg : entry.second) path.flights.push_back(leg->flight);
+            result.push_back(path);
+        }
+        return result;
+    }
+};
+
+
+// Parses a data file with one task per newline-aligned chunk and returns
+// the records in file order, their text stored in arena. Small files are
+// parsed on the calling thread.
+template <typename Record>
+vector<Record> parseRecordsParallel(const string& path, unsigned threads, TextArena& arena) {
+    const size_t MIN_CHUNK_BYTES = 1 << 20;
+
+    MappedFile file(path);
+    string_view data = file.view();
+    size_t chunks = min<size_t>(max(threads, 1u), data.size() / MIN_CHUNK_BYTES + 1);
+
+    vector<size_t> bounds(1, 0);
+    for (size_t c = 1; c < chunks; c++) {
+        size_t pos = data.find('\n', max(bounds.back(), data.size() * c / chunks));
+        if (pos == string_view::npos) break;
+        bounds.push_back(pos + 1);
+    }
+    bounds.push_back(data.size());
+
+    vector<vector<Record>> parsed(bounds.size() - 1);
+    runParallel((unsigned)parsed.size(), [&](unsigned c) {
+        TextArena::Use use(arena);
+        string_view chunk = data.substr(bounds[c], bounds[c + 1] - bounds[c]);
+        parsed[c].reserve(count(chunk.begin(), chunk.end(), '\n') + 1);
+        size_t prev = 0;
+        while (prev < chunk.size()) {
+            size_t pos = chunk.find('\n', prev);
+            if (pos == string_view::npos) pos = chunk.size();
+            if (pos > prev) parsed[c].push_back(Record::fromFileString(chunk.substr(prev, pos - prev)));
+            prev = pos + 1;
+        }
+    });
+
+    if (parsed.size() == 1) return move(parsed[0]);
+    size_t total = 0;
+    for (const auto& part : parsed) total += part.size();
+    vector<Record> records;
+    records.reserve(total);
+    for (auto& part : parsed) {
+        move(part.begin(), part.end(), back_inserter(records));
+    }
+    return records;
+}
+
+
+// Append-only write-ahead log. Each mutation is one "TYPE|payload" line,
+// ended by "#" and the CRC-32 of the rest in 8 hex digits so that a line
+// glued onto a torn one is rejected. write() queues a group of lines on a bounded lock-free ring and returns
+// its sequence number; a persistence thread drains the ring, appends
+// everything queued (plus whatever arrives within the commit window) in one
+// write, fsyncs once and acknowledges every sync(seq) it covered. A failed
+// write or fsync fails every sync until the next rotation or reset().
+// rotate() starts a fresh log for a background checkpoint; the previous one
+// is kept as path + ".old" until discardRotated(), and replay reads both.
+class Journal {
+private:
+    static constexpr size_t QUEUE_SLOTS = 4096;
+
+    // A slot is free for the producer at position p when turn == p and full
+    // for the consumer when turn == p + 1.
+    struct Slot {
+        atomic<uint64_t> turn;
+        string group;
+        size_t records;
+    };
+
+    string path;
+    string rotatedPath;
+    int fd;
+    atomic<size_t> recordCount;
+    unique_ptr<Slot[]> slots;
+    atomic<uint64_t> tail;
+    uint64_t head;  // persistence thread only
+    atomic<long long> commitWindowUs;
+    mutex fileMutex;
+
+    mutex signalMutex;
+    condition_variable workReady;
+    condition_variable durableChanged;
+    uint64_t requestedSeq;
+    uint64_t durableSeq;
+    bool broken;  // a write failed since the log was last started afresh
+    bool stopping;
+    bool rotationPending;
+    bool rotated;
+    uint64_t rotateAt;
+    thread persister;
+
+    Journal(const Journal&);
+    Journal& operator=(const Journal&);
+
+    bool openFile(bool truncate) {
+        closeFile();
+        #ifdef _WIN32
+            int flags = _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : 0);
+            fd = _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+        #else
+            int flags = O_WRONLY | O_APPEND | O_CREAT | (truncate ? O_TRUNC : 0);
+            fd = ::open(path.c_str(), flags, 0644);
+        #endif
+        return fd >= 0;
+    }
+
+    void closeFile() {
+        if (fd >= 0) {
+            #ifdef _WIN32
+                _close(fd);
+            #else
+                ::close(fd);
+            #endif
+            fd = -1;
+        }
+    }
+
+    bool writeAll(const string& data) {
+        size_t written = 0;
+        while (written < data.size()) {
+            #ifdef _WIN32
+                int n = _write(fd, data.data() + written, (unsigned)(data.size() - written));
+            #else
+                ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+            #endif
+            if (n <= 0) return false;
+            written += (size_t)n;
+        }
+        return true;
+    }
+
+    bool flushToDisk() {
+        #ifdef _WIN32
+            return _commit(fd) == 0;
+        #else
+            return fsync(fd) == 0;
+        #endif
+    }
+
+    // Takes queued groups in order up to at least target (waiting out
+    // producers still filling their slot), then anything else ready, but
+    // never past limit.
+    void drain(uint64_t target, uint64_t limit, string& batch, size_t& records) {
+        while (head < limit) {
+            Slot& slot = slots[head % QUEUE_SLOTS];
+            if (slot.turn.load(memory_order_acquire) != head + 1) {
+                if (head >= target) return;
+                this_thread::yield();
+                continue;
+            }
+            batch += slot.group;
+            records += slot.records;
+            slot.group.clear();
+            slot.turn.store(head + QUEUE_SLOTS, memory_order_release);
+            head++;
+        }
+    }
+
+    // Writes and fsyncs what drain() takes; nothing taken, nothing written.
+    bool persist(uint64_t target, uint64_t limit) {
+        string batch;
+        size_t records = 0;
+        drain(target, limit, batch, records);
+        if (batch.empty()) return true;
+        bool ok;
+        {
+            lock_guard<mutex> file(fileMutex);
+            ok = (fd >= 0 || openFile(false)) && writeAll(batch) && flushToDisk();
+        }
+        ARS_COUNT(Counter::JournalBytesWritten, batch.size());
+        ARS_COUNT(Counter::JournalSyncs, 1);
+        ARS_COUNT(Counter::JournalRecordsSynced, records);
+        return ok;
+    }
+
+    // Moves the log aside and reopens it empty. If an earlier rotated log
+    // was never discarded (its checkpoint failed) this one is appended to
+    // it; a crash part way through then replays some records twice, which
+    // replay already tolerates after a crash between snapshot and reset().
+    bool rotateFile() {
+        closeFile();
+        error_code error;
+        if (!filesystem::exists(path, error)) return openFile(true);
+        if (filesystem::exists(rotatedPath, error)) {
+            ifstream current(path, ios::binary);
+            string contents((istreambuf_iterator<char>(current)), istreambuf_iterator<char>());
+            ofstream old(rotatedPath, ios::binary | ios::app);
+            old.write(contents.data(), contents.size());
+            old.close();
+            if (!old || !syncPath(rotatedPath)) return false;
+        } else {
+            filesystem::rename(path, rotatedPath, error);
+            if (error) return false;
+        }
+        return openFile(true) && syncDirectoryOf(path);
+    }
+
+    void runPersister() {
+        unique_lock<mutex> guard(signalMutex);
+        while (true) {
+            workReady.wait(guard, [this]() { return stopping || rotationPending || requestedSeq > durableSeq; });
+            uint64_t target = stopping ? tail.load() : requestedSeq;
+            bool rotation = rotationPending;
+            uint64_t rotationSeq = rotateAt;
+            if (stopping && !rotation && target <= durableSeq) return;
+            guard.unlock();
+            
+            long long windowUs = commitWindowUs.load(memory_order_relaxed);
+            if (windowUs > 0 && !stopping && !rotation) this_thread::sleep_for(chrono::microseconds(windowUs));
+            bool ok = true, moved = false;
+            if (rotation) {
+                ok = persist(rotationSeq, rotationSeq);
+                lock_guard<mutex> file(fileMutex);
+                moved = ok && rotateFile();
+            }
+            ok = persist(target, UINT64_MAX) && ok;
+            
+            guard.lock();
+            if (rotation) {
+                rotationPending = false;
+                rotated = moved;
+            }
+            // A failed write leaves a gap in the log; once it has been moved
+            // aside and the new one written cleanly, later records are safe.
+            if (!ok) broken = true;
+            else if (moved) broken = false;
+            durableSeq = head;
+            durableChanged.notify_all();
+        }
+    }
+
+    static void appendLine(string& out, const string& record) {
+        char checksum[10];
+        snprintf(checksum, sizeof(checksum), "#%08x", crc32(record.data(), record.size()));
+        out += record;
+        out += checksum;
+        out += '\n';
+    }
+
+    // Strips a line's checksum, returning false when it does not match.
+    // Lines written before checksums were added have none and are kept.
+    static bool checkLine(string& line) {
+        static const size_t SUFFIX = 9;
+        if (line.size() < SUFFIX || line[line.size() - SUFFIX] != '#') return true;
+        uint32_t expected = 0;
+        for (size_t i = line.size() - SUFFIX + 1; i < line.size(); i++) {
+            char c = line[i];
+            int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+            if (digit < 0) return true;
+            expected = expected << 4 | (uint32_t)digit;
+        }
+        line.resize(line.size() - SUFFIX);
+        return crc32(line.data(), line.size()) == expected;
+    }
+
+    // Cuts the file back to its first length bytes, dropping a torn tail
+    // so that records appended after a restart start on a line of their own.
+    static void truncateTo(const string& file, uintmax_t length) {
+        error_code error;
+        uintmax_t size = filesystem::file_size(file, error);
+        if (error || size <= length) return;
+        filesystem::resize_file(file, length, error);
+        if (!error) syncPath(file);
+    }
+
+    template <typename Apply>
+    static size_t replayFile(const string& file, Apply& apply) {
+        ifstream in(file, ios::binary);
+        size_t applied = 0;
+        if (in.is_open()) {
+            string line;
+            vector<string> group;
+            size_t groupSize = 0;
+            // committed is where the last whole record or group ends; a
+            // group still missing records at the end is as torn as a line.
+            uintmax_t offset = 0, committed = 0;
+            while (getline(in, line)) {
+                if (in.eof()) break;
+                if (groupSize == 0) committed = offset;
+                offset += line.size() + 1;
+                if (!checkLine(line)) {
+                    group.clear();
+                    groupSize = 0;
+                    continue;
+                }
+                if (line.size() < 2 || line[1] != '|') continue;
+                if (line[0] == 'G') {
+                    group.clear();
+                    groupSize = (size_t)strtoul(line.c_str() + 2, nullptr, 10);
+                    continue;
+                }
+                if (groupSize > 0) {
+                    group.push_back(line);
+                    if (group.size() < groupSize) continue;
+                    for (const auto& record : group) apply(record[0], record.substr(2));
+                    applied += group.size();
+                    group.clear();
+                    groupSize = 0;
+                    continue;
+                }
+                apply(line[0], line.substr(2));
+                applied++;
+            }
+            in.close();
+            if (groupSize == 0) committed = offset;
+            truncateTo(file, committed);
+        }
+        return applied;
+    }
+
+public:
+    explicit Journal(const string& file)
+        : path(file), rotatedPath(file + ".old"), fd(-1), recordCount(0), slots(new Slot[QUEUE_SLOTS]),
+          tail(0), head(0), commitWindowUs(0), requestedSeq(0), durableSeq(0), broken(false),
+          stopping(false), rotationPending(false), rotated(false), rotateAt(0) {
+        for (size_t i = 0; i < QUEUE_SLOTS; i++) slots[i].turn.store(i, memory_order_relaxed);
+        persister = thread(&Journal::runPersister, this);
+    }
+
+    // Whatever is still queued is written before the thread exits.
+    ~Journal() {
+        {
+            lock_guard<mutex> guard(signalMutex);
+            stopping = true;
+        }
+        workReady.notify_one();
+        persister.join();
+        closeFile();
+    }
+
+    size_t size() const { return recordCount.load(memory_order_relaxed); }
+
+    // How long the persistence thread waits for more records after the
+    // first sync request before writing; 0 writes at once, batching only
+    // what queued up during the previous fsync.
+    void setCommitWindow(chrono::microseconds window) { commitWindowUs = window.count(); }
+
+    // Several records are framed as "G|<count>" followed by the records, so
+    // replay applies the whole group or, if the tail was torn, none of it.
+    // Lock-free; waits only while the ring is full. Write errors surface
+    // from sync().
+    void write(const vector<string>& records, uint64_t& seq) {
+        string group;
+        if (records.size() > 1) appendLine(group, "G|" + to_string(records.size()));
+        for (const auto& r : records) appendLine(group, r);
+        
+        uint64_t position = tail.load(memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[position % QUEUE_SLOTS];
+            uint64_t turn = slot->turn.load(memory_order_acquire);
+            if (turn == position) {
+                if (tail.compare_exchange_weak(position, position + 1, memory_order_relaxed)) break;
+            } else if (turn < position) {
+                this_thread::yield();
+                position = tail.load(memory_order_relaxed);
+            } else {
+                position = tail.load(memory_order_relaxed);
+            }
+        }
+        slot->group = move(group);
+        slot->records = records.size();
+        slot->turn.store(position + 1, memory_order_release);
+        recordCount += records.size();
+        seq = position + 1;
+    }
+
+    // Blocks until seq is on disk; false while the log has a gap from a
+    // failed write (until rotate() or reset() starts a fresh one).
+    bool sync(uint64_t seq) {
+        unique_lock<mutex> guard(signalMutex);
+        if (durableSeq < seq) {
+            if (requestedSeq < seq) {
+                requestedSeq = seq;
+                workReady.notify_one();
+            }
+            durableChanged.wait(guard, [this, seq]() { return durableSeq >= seq; });
+        }
+        return !broken;
+    }
+
+    bool append(const vector<string>& records) {
+        uint64_t seq;
+        write(records, seq);
+        return sync(seq);
+    }
+
+    bool append(const string& record) {
+        return append(vector<string>(1, record));
+    }
+
+    // Applies every complete record, the rotated log's first. A trailing
+    // line without its newline, or a trailing group short of records, is a
+    // torn write from a crash: it is ignored and cut from the file before
+    // anything new is appended.
+    template <typename Apply>
+    size_t replay(Apply apply) {
+        size_t applied = replayFile(rotatedPath, apply) + replayFile(path, apply);
+        recordCount = applied;
+        return applied;
+    }
+
+    // Called with no writers running. Records queued so far go to the old
+    // log, which stays (and is replayed) until discardRotated(); size()
+    // restarts from zero. Returns at once; see awaitRotation().
+    void rotate() {
+        lock_guard<mutex> guard(signalMutex);
+        rotationPending = true;
+        rotateAt = tail.load();
+        recordCount = 0;
+        workReady.notify_one();
+    }
+
+    // Waits for the last rotate() and returns whether the log was moved.
+    bool awaitRotation() {
+        unique_lock<mutex> guard(signalMutex);
+        durableChanged.wait(guard, [this]() { return !rotationPending; });
+        return rotated;
+    }
+
+    // Called once the snapshot files hold everything the rotated log does.
+    bool discardRotated() {
+        lock_guard<mutex> file(fileMutex);
+        error_code error;
+        filesystem::remove(rotatedPath, error);
+        return !error && syncDirectoryOf(path);
+    }
+
+    // Called once the snapshot files hold everything both logs describe,
+    // with no writers running. Groups still queued are flushed first.
+    bool reset() {
+        sync(tail.load());
+        lock_guard<mutex> file(fileMutex);
+        recordCount = 0;
+        error_code error;
+        filesystem::remove(rotatedPath, error);
+        bool opened = openFile(true);
+        lock_guard<mutex> guard(signalMutex);
+        broken = !opened;
+        return opened;
+    }
+};
+
+
+// Hashed timer wheel: each entry is filed under the slot of its deadline tick
+// and advancing visits only the slots whose tick has passed, so expiring costs
+// O(expired) rather than a scan of every live entry. Deadlines more than one
+// turn away simply stay in their slot until their turn comes round.
+// Entries are never removed early; the expire callback skips stale ones.
+class TimerWheel {
+public:
+    static constexpr size_t SLOTS = 4096;
+
+private:
+    struct Entry {
+        string id;
+        uint64_t deadline;
+    };
+    vector<vector<Entry>> slots;
+    uint64_t nextTick;
+    size_t pending;
+
+public:
+    explicit TimerWheel(uint64_t now = 0) : slots(SLOTS), nextTick(now), pending(0) {}
+
+    void schedule(const string& id, uint64_t deadline) {
+        slots[max(deadline, nextTick) % SLOTS].push_back(Entry{id, deadline});
+        pending++;
+    }
+
+    size_t size() const { return pending; }
+
+    // Calls expire(id) for every entry whose deadline is at or before now.
+    template <class Expire>
+    void advance(uint64_t now, Expire expire) {
+        if (now < nextTick) return;
+        uint64_t steps = min<uint64_t>(now - nextTick + 1, SLOTS);
+        for (uint64_t i = 0; i < steps && pending > 0; i++) {
+            vector<Entry>& slot = slots[(nextTick + i) % SLOTS];
+            size_t kept = 0;
+            for (size_t j = 0; j < slot.size(); j++) {
+                if (slot[j].deadline <= now) {
+                    expire(slot[j].id);
+                    pending--;
+                } else {
+                    if (kept != j) slot[kept] = move(slot[j]);
+                    kept++;
+                }
+            }
+            slot.resize(kept);
+        }
+        nextTick = now + 1;
+    }
+};
+
+
+struct BookingResult {
+    bool success;
+    string error;
+    Booking booking;
+};
+
+struct BookingPage {
+    vector<Booking> bookings;
+    size_t total;  // bookings from the requested date on, across all pages
+};
+
+struct HoldResult {
+    bool success;
+    string error;
+    string holdId;
+    string seat;
+};
+
+// One flight's share of a batch booking: seatCount seats picked by the
+// system, or exactly the listed seats when seats is not empty.
+struct BatchLeg {
+    string flightNumber;
+    int seatCount;
+    vector<string> seats;
+};
+
+struct BatchBookingResult {
+    bool success;
+    string error;
+    vector<Booking> bookings;
+};
+
+// Result of registrations and flight add/remove; id is the new record's ID.
+struct OperationResult {
+    bool success;
+    string error;
+    string id;
+};
+
+struct FlightQuery {
+    string origin;
+    string destination;
+    string date;
+    bool onlyAvailable = true;
+};
+
+struct FlightOccupancy {
+    string flightNumber;
+    string origin;
+    string destination;
+    int totalSeats;
+    int bookedSeats;
+    int heldSeats;      // on hold; not counted in bookedSeats or occupancy
+    double occupancy;
+};
+
+struct ConnectionQuery {
+    string origin;
+    string destination;
+    string date;
+    size_t maxLegs = 3;
+    int minConnectionMinutes = 30;
+    int maxLayoverMinutes = 12 * 60;
+    size_t topK = 5;
+    ItinerarySort sortBy = ItinerarySort::EarliestArrival;
+};
+
+struct SalesTotals {
+    int confirmed = 0;
+    int cancelled = 0;
+    double revenue = 0.0;
+};
+
+struct SystemReport {
+    int totalFlights;
+    int totalPassengers;
+    int totalBookings;
+    int confirmedBookings;
+    int cancelledBookings;
+    int totalSeats;
+    int bookedSeats;
+    double totalRevenue;
+    vector<pair<string, int>> topRoutes;
+    vector<pair<string, SalesTotals>> airlines;
+};
+
+
+// Running report counters kept per flight, per route, per airline and
+// overall, updated as bookings are made or cancelled and flights come and go,
+// so reports never rescan the bookings. Keyed by symbol; names are looked up
+// only when a report is filled. Rebuilt from scratch after loading.
+class ReportAggregates {
+private:
+    struct FlightTotals {
+        uint64_t route;
+        uint32_t airline;
+        int seats;
+        SalesTotals sales;
+    };
+
+    mutable mutex lock;
+    SalesTotals global;
+    int totalSeats;
+    int bookedSeats;
+    unordered_map<uint32_t, FlightTotals> byFlight;
+    unordered_map<uint64_t, SalesTotals> byRoute;
+    unordered_map<uint32_t, SalesTotals> byAirline;
+
+    static void apply(SalesTotals& totals, int confirmed, int cancelled, double revenue) {
+        totals.confirmed += confirmed;
+        totals.cancelled += cancelled;
+        totals.revenue += revenue;
+    }
+
+    // Bookings on flights that no longer exist only count towards the totals.
+    void record(uint32_t flight, int confirmed, int cancelled, double revenue) {
+        apply(global, confirmed, cancelled, revenue);
+        auto it = byFlight.find(flight);
+        if (it == byFlight.end()) return;
+        apply(it->second.sales, confirmed, cancelled, revenue);
+        apply(byRoute[it->second.route], confirmed, cancelled, revenue);
+        apply(byAirline[it->second.airline], confirmed, cancelled, revenue);
+        bookedSeats += confirmed;
+    }
+
+    void addFlightLocked(const Flight& f) {
+        FlightTotals& totals = byFlight[f.getFlightSymbol()];
+        totals.route = cityPairOf(f);
+        totals.airline = f.getAirlineSymbol();
+        totals.seats = f.getTotalSeats();
+        totalSeats += totals.seats;
+    }
+
+public:
+    ReportAggregates() : totalSeats(0), bookedSeats(0) {}
+
+    void flightAdded(const Flight& f) {
+        lock_guard<mutex> guard(lock);
+        addFlightLocked(f);
+    }
+
+    void flightRemoved(uint32_t flight) {
+        lock_guard<mutex> guard(lock);
+        auto it = byFlight.find(flight);
+        if (it == byFlight.end()) return;
+        totalSeats -= it->second.seats;
+        bookedSeats -= it->second.sales.confirmed;
+        byFlight.erase(it);
+    }
+
+    void booked(uint32_t flight, double fare) {
+        lock_guard<mutex> guard(lock);
+        record(flight, 1, 0, fare);
+    }
+
+    void cancelled(uint32_t flight, double fare) {
+        lock_guard<mutex> guard(lock);
+        record(flight, -1, 1, -fare);
+    }
+
+    template <typename Flights, typename Bookings>
+    void rebuild(const Flights& flights, const Bookings& bookings) {
+        lock_guard<mutex> guard(lock);
+        global = SalesTotals();
+        totalSeats = bookedSeats = 0;
+        byFlight.clear();
+        byRoute.clear();
+        byAirline.clear();
+        for (const auto& f : flights) addFlightLocked(f);
+        for (const auto& b : bookings) {
+            // Any other status (PENDING, or unknown text from disk) is neither.
+            if (b.isConfirmed()) record(b.getFlightSymbol(), 1, 0, b.getTotalFare());
+            else if (b.isCancelled()) record(b.getFlightSymbol(), 0, 1, 0.0);
+        }
+    }
+
+    // Fills the fleet, booking and revenue figures and the rankings; routes
+    // by confirmed bookings, airlines by revenue.
+    void fill(SystemReport& report, size_t topRoutes) const {
+        lock_guard<mutex> guard(lock);
+        report.totalFlights = byFlight.size();
+        report.totalSeats = totalSeats;
+        report.bookedSeats = bookedSeats;
+        report.confirmedBookings = global.confirmed;
+        report.cancelledBookings = global.cancelled;
+        report.totalBookings = global.confirmed + global.cancelled;
+        report.totalRevenue = global.revenue;
+        
+        report.topRoutes.clear();
+        for (const auto& route : byRoute) {
+            if (route.second.confirmed > 0) {
+                report.topRoutes.push_back(make_pair(cityPairName(route.first), route.second.confirmed));
+            }
+        }
+        sort(report.topRoutes.begin(), report.topRoutes.end(),
+             [](const pair<string, int>& a, const pair<string, int>& b) {
+                 return a.second != b.second ? a.second > b.second : a.first < b.first;
+             });
+        if (report.topRoutes.size() > topRoutes) report.topRoutes.resize(topRoutes);
+        
+        report.airlines.clear();
+        for (const auto& airline : byAirline) {
+            report.airlines.push_back(make_pair(symbolName(airline.first), airline.second));
+        }
+        sort(report.airlines.begin(), report.airlines.end(),
+             [](const pair<string, SalesTotals>& a, const pair<string, SalesTotals>& b) {
+                 return a.second.revenue != b.second.revenue ? a.second.revenue > b.second.revenue
+                                                             : a.first < b.first;
+             });
+    }
+};
+
+
+// Report kernels over packed status/fare/key arrays. Status byte 0 means
+// confirmed and 1 cancelled (BookingColumns::Status). Each kernel has a
+// scalar version and x86 SSE2/AVX2 versions compiled with per-function
+// target attributes; the level is picked once at runtime from CPUID.
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+struct StatusTotals {
+    size_t confirmed;
+    size_t cancelled;
+    double revenue;
+};
+
+inline SimdLevel detectSimdLevel() {
+#ifdef ARS_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+inline SimdLevel activeSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::SSE2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+inline StatusTotals sumStatusScalar(const uint8_t* status, const double* fare, size_t n) {
+    StatusTotals totals = {0, 0, 0.0};
+    for (size_t i = 0; i < n; i++) {
+        totals.confirmed += status[i] == 0;
+        totals.cancelled += status[i] == 1;
+        totals.revenue += fare[i] * (status[i] == 0);
+    }
+    return totals;
+}
+
+inline void sumByGroupScalar(const uint8_t* status, const double* fare, const uint32_t* keys,
+                             const uint32_t* keyGroup, size_t n, double* sums) {
+    for (size_t i = 0; i < n; i++) {
+        sums[keyGroup[keys[i]]] += fare[i] * (status[i] == 0);
+    }
+}
+
+#ifdef ARS_X86_SIMD
+// Lane masks for every combination of 4 (AVX2) or 2 (SSE2) confirmed rows,
+// indexed by the matching bits of a byte-compare movemask.
+alignas(32) static const uint64_t CONFIRMED_LANES[16][4] = {
+    {0, 0, 0, 0}, {~0ull, 0, 0, 0}, {0, ~0ull, 0, 0}, {~0ull, ~0ull, 0, 0},
+    {0, 0, ~0ull, 0}, {~0ull, 0, ~0ull, 0}, {0, ~0ull, ~0ull, 0}, {~0ull, ~0ull, ~0ull, 0},
+    {0, 0, 0, ~0ull}, {~0ull, 0, 0, ~0ull}, {0, ~0ull, 0, ~0ull}, {~0ull, ~0ull, 0, ~0ull},
+    {0, 0, ~0ull, ~0ull}, {~0ull, 0, ~0ull, ~0ull}, {0, ~0ull, ~0ull, ~0ull}, {~0ull, ~0ull, ~0ull, ~0ull}
+};
+
+__attribute__((target("sse2")))
+inline StatusTotals sumStatusSSE2(const uint8_t* status, const double* fare, size_t n) {
+    StatusTotals totals = {0, 0, 0.0};
+    const __m128i confirmedByte = _mm_setzero_si128();
+    const __m128i cancelledByte = _mm_set1_epi8(1);
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(status + i));
+        unsigned confirmed = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, confirmedByte));
+        unsigned cancelled = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, cancelledByte));
+        totals.confirmed += __builtin_popcount(confirmed);
+        totals.cancelled += __builtin_popcount(cancelled);
+        for (int k = 0; k < 16; k += 4) {
+            __m128d lo = _mm_load_pd((const double*)CONFIRMED_LANES[(confirmed >> k) & 3]);
+            __m128d hi = _mm_load_pd((const double*)CONFIRMED_LANES[(confirmed >> (k + 2)) & 3]);
+            acc0 = _mm_add_pd(acc0, _mm_and_pd(_mm_loadu_pd(fare + i + k), lo));
+            acc1 = _mm_add_pd(acc1, _mm_and_pd(_mm_loadu_pd(fare + i + k + 2), hi));
+        }
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    StatusTotals tail = sumStatusScalar(status + i, fare + i, n - i);
+    totals.confirmed += tail.confirmed;
+    totals.cancelled += tail.cancelled;
+    totals.revenue = lanes[0] + lanes[1] + tail.revenue;
+    return totals;
+}
+
+__attribute__((target("avx2")))
+inline StatusTotals sumStatusAVX2(const uint8_t* status, const double* fare, size_t n) {
+    StatusTotals totals = {0, 0, 0.0};
+    const __m256i confirmedByte = _mm256_setzero_si256();
+    const __m256i cancelledByte = _mm256_set1_epi8(1);
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(status + i));
+        unsigned confirmed = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, confirmedByte));
+        unsigned cancelled = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, cancelledByte));
+        totals.confirmed += __builtin_popcount(confirmed);
+        totals.cancelled += __builtin_popcount(cancelled);
+        for (int k = 0; k < 32; k += 8) {
+            __m256d lo = _mm256_load_pd((const double*)CONFIRMED_LANES[(confirmed >> k) & 15]);
+            __m256d hi = _mm256_load_pd((const double*)CONFIRMED_LANES[(confirmed >> (k + 4)) & 15]);
+            acc0 = _mm256_add_pd(acc0, _mm256_and_pd(_mm256_loadu_pd(fare + i + k), lo));
+            acc1 = _mm256_add_pd(acc1, _mm256_and_pd(_mm256_loadu_pd(fare + i + k + 4), hi));
+        }
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    StatusTotals tail = sumStatusScalar(status + i, fare + i, n - i);
+    totals.confirmed += tail.confirmed;
+    totals.cancelled += tail.cancelled;
+    totals.revenue = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + tail.revenue;
+    return totals;
+}
+
+// Groups and masked fares are formed 8 rows at a time (group IDs with one
+// gather). The scatter-add stays scalar, as x86 has no conflict-free
+// scatter below AVX-512, but alternates between four copies of the sums so
+// runs of rows on the same group do not serialize on one memory slot.
+__attribute__((target("avx2")))
+inline void sumByGroupAVX2(const uint8_t* status, const double* fare, const uint32_t* keys,
+                           const uint32_t* keyGroup, size_t n, double* sums, size_t groups) {
+    vector<double> partial(groups * 4, 0.0);
+    double* lanes[4] = {partial.data(), partial.data() + groups, partial.data() + 2 * groups,
+                        partial.data() + 3 * groups};
+    alignas(32) uint32_t group[8];
+    alignas(32) double masked[8];
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i key = _mm256_loadu_si256((const __m256i*)(keys + i));
+        _mm256_store_si256((__m256i*)group, _mm256_i32gather_epi32((const int*)keyGroup, key, 4));
+        __m128i bytes = _mm_loadl_epi64((const __m128i*)(status + i));
+        unsigned confirmed = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_setzero_si128())) & 0xFF;
+        __m256d lo = _mm256_load_pd((const double*)CONFIRMED_LANES[confirmed & 15]);
+        __m256d hi = _mm256_load_pd((const double*)CONFIRMED_LANES[confirmed >> 4]);
+        _mm256_store_pd(masked, _mm256_and_pd(_mm256_loadu_pd(fare + i), lo));
+        _mm256_store_pd(masked + 4, _mm256_and_pd(_mm256_loadu_pd(fare + i + 4), hi));
+        for (int k = 0; k < 8; k++) lanes[k & 3][group[k]] += masked[k];
+    }
+    for (size_t g = 0; g < groups; g++) sums[g] += (lanes[0][g] + lanes[1][g]) + (lanes[2][g] + lanes[3][g]);
+    sumByGroupScalar(status + i, fare + i, keys + i, keyGroup, n - i, sums);
+}
+#endif
+
+// Confirmed/cancelled counts and confirmed revenue.
+inline StatusTotals sumStatus(const uint8_t* status, const double* fare, size_t n,
+                              SimdLevel level = activeSimdLevel()) {
+#ifdef ARS_X86_SIMD
+    if (level == SimdLevel::AVX2) return sumStatusAVX2(status, fare, n);
+    if (level == SimdLevel::SSE2) return sumStatusSSE2(status, fare, n);
+#endif
+    (void)level;
+    return sumStatusScalar(status, fare, n);
+}
+
+// sums[keyGroup[keys[i]]] += fare[i] over confirmed rows, for group IDs
+// below groups. SSE2 has no gather, so it uses the scalar loop.
+inline void sumByGroup(const uint8_t* status, const double* fare, const uint32_t* keys,
+                       const uint32_t* keyGroup, size_t n, double* sums, size_t groups,
+                       SimdLevel level = activeSimdLevel()) {
+#ifdef ARS_X86_SIMD
+    if (level == SimdLevel::AVX2) return sumByGroupAVX2(status, fare, keys, keyGroup, n, sums, groups);
+#endif
+    (void)level;
+    (void)groups;
+    sumByGroupScalar(status, fare, keys, keyGroup, n, sums);
+}
+
+
+// Struct-of-arrays mirror of the bookings for analytics: flight and
+// passenger symbols, status as one byte, booking date as a day number and
+// the fare as a plain double. Each flight symbol maps to a route and airline
+// group, so grouped revenue is one pass of array reads into a sum per group.
+// Built on first use and then appended to alongside the bookings.
+class BookingColumns {
+public:
+    enum Status : uint8_t { CONFIRMED = 0, CANCELLED = 1, OTHER = 2 };
+
+private:
+    // Dense group numbers for the city pairs or airline symbols seen, so
+    // the sums stay small however many symbols there are. Group 0 is
+    // "(unknown)".
+    template <typename Key>
+    struct Groups {
+        unordered_map<Key, uint32_t> ids;
+        vector<Key> keys;
+
+        uint32_t of(Key key) {
+            auto it = ids.emplace(key, (uint32_t)keys.size() + 1);
+            if (it.second) keys.push_back(key);
+            return it.first->second;
+        }
+
+        size_t size() const { return keys.size() + 1; }
+
+        void clear() {
+            ids.clear();
+            keys.clear();
+        }
+    };
+
+    mutable shared_mutex lock;
+    bool built;
+    Groups<uint64_t> routes;
+    Groups<uint32_t> airlines;
+    vector<uint32_t> flightRoute;    // by flight symbol
+    vector<uint32_t> flightAirline;
+    
+    vector<uint32_t> flightColumn;
+    vector<uint32_t> passengerColumn;
+    vector<uint8_t> statusColumn;
+    vector<int32_t> dateColumn;
+    vector<double> fareColumn;
+    unordered_map<int32_t, uint32_t> rowOf;  // by Booking::getBookingKey()
+
+    // Flights never described (removed before this run) group under the
+    // "(unknown)" route and airline.
+    uint32_t flightIdOf(uint32_t flight) {
+        if (flight >= flightRoute.size()) {
+            flightRoute.resize(flight + 1, 0);
+            flightAirline.resize(flight + 1, 0);
+        }
+        return flight;
+    }
+
+    void describeLocked(const Flight& f) {
+        uint32_t id = flightIdOf(f.getFlightSymbol());
+        flightRoute[id] = routes.of(cityPairOf(f));
+        flightAirline[id] = airlines.of(f.getAirlineSymbol());
+    }
+
+    void appendLocked(const Booking& b) {
+        rowOf[b.getBookingKey()] = (uint32_t)fareColumn.size();
+        flightColumn.push_back(flightIdOf(b.getFlightSymbol()));
+        passengerColumn.push_back(b.getPassengerSymbol());
+        statusColumn.push_back(b.isConfirmed() ? CONFIRMED : b.isCancelled() ? CANCELLED : OTHER);
+        dateColumn.push_back(b.getBookingDay());
+        fareColumn.push_back(b.getTotalFare());
+    }
+
+    // Confirmed revenue summed into sums[group(row)]. The status test is a
+    // multiply, so the loop body has no data-dependent branch.
+    template <typename GroupOf>
+    vector<double> sumConfirmed(size_t groups, GroupOf group) const {
+        vector<double> sums(groups, 0.0);
+        const uint8_t* status = statusColumn.data();
+        const double* fare = fareColumn.data();
+        for (size_t i = 0, n = fareColumn.size(); i < n; i++) {
+            sums[group(i)] += fare[i] * (status[i] == CONFIRMED);
+        }
+        return sums;
+    }
+
+    template <typename Key, typename Name>
+    static vector<pair<string, double>> labelled(const Groups<Key>& groups, const vector<double>& sums, Name name) {
+        vector<pair<string, double>> result;
+        for (size_t i = 0; i < sums.size(); i++) {
+            if (sums[i] != 0.0) result.push_back(make_pair(i ? name(groups.keys[i - 1]) : "(unknown)", sums[i]));
+        }
+        sort(result.begin(), result.end(), [](const pair<string, double>& a, const pair<string, double>& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        return result;
+    }
+
+public:
+    BookingColumns() : built(false) {
+        clear();
+    }
+
+    bool isBuilt() const {
+        shared_lock<shared_mutex> guard(lock);
+        return built;
+    }
+
+    void clear() {
+        unique_lock<shared_mutex> guard(lock);
+        built = false;
+        routes.clear();
+        airlines.clear();
+        flightRoute.clear();
+        flightAirline.clear();
+        flightColumn.clear();
+        passengerColumn.clear();
+        statusColumn.clear();
+        dateColumn.clear();
+        fareColumn.clear();
+        rowOf.clear();
+    }
+
+    template <typename Flights, typename Bookings>
+    void build(const Flights& flights, const Bookings& bookings) {
+        unique_lock<shared_mutex> guard(lock);
+        if (built) return;
+        for (const auto& f : flights) describeLocked(f);
+        rowOf.reserve(bookings.size());
+        flightColumn.reserve(bookings.size());
+        passengerColumn.reserve(bookings.size());
+        statusColumn.reserve(bookings.size());
+        dateColumn.reserve(bookings.size());
+        fareColumn.reserve(bookings.size());
+        for (const auto& b : bookings) appendLocked(b);
+        built = true;
+    }
+
+    // The updates below are no-ops until the mirror has been built.
+    void describeFlight(const Flight& f) {
+        unique_lock<shared_mutex> guard(lock);
+        if (built) describeLocked(f);
+    }
+
+    void append(const Booking& b) {
+        unique_lock<shared_mutex> guard(lock);
+        if (built) appendLocked(b);
+    }
+
+    void setStatus(int32_t bookingKey, Status status) {
+        unique_lock<shared_mutex> guard(lock);
+        auto it = rowOf.find(bookingKey);
+        if (it != rowOf.end()) statusColumn[it->second] = status;
+    }
+
+    size_t rows() const {
+        shared_lock<shared_mutex> guard(lock);
+        return fareColumn.size();
+    }
+
+    StatusTotals statusTotals(SimdLevel level = activeSimdLevel()) const {
+        shared_lock<shared_mutex> guard(lock);
+        return sumStatus(statusColumn.data(), fareColumn.data(), fareColumn.size(), level);
+    }
+
+    vector<pair<string, double>> revenueByRoute(SimdLevel level = activeSimdLevel()) const {
+        shared_lock<shared_mutex> guard(lock);
+        vector<double> sums(routes.size(), 0.0);
+        sumByGroup(statusColumn.data(), fareColumn.data(), flightColumn.data(), flightRoute.data(),
+                   fareColumn.size(), sums.data(), sums.size(), level);
+        return labelled(routes, sums, cityPairName);
+    }
+
+    vector<pair<string, double>> revenueByAirline(SimdLevel level = activeSimdLevel()) const {
+        shared_lock<shared_mutex> guard(lock);
+        vector<double> sums(airlines.size(), 0.0);
+        sumByGroup(statusColumn.data(), fareColumn.data(), flightColumn.data(), flightAirline.data(),
+                   fareColumn.size(), sums.data(), sums.size(), level);
+        return labelled(airlines, sums, symbolName);
+    }
+
+    // Keyed by booking day number, ascending; undated bookings are left out.
+    vector<pair<int, double>> revenueByDay() const {
+        shared_lock<shared_mutex> guard(lock);
+        vector<pair<int, double>> result;
+        int first = numeric_limits<int>::max(), last = -1;
+        for (int32_t day : dateColumn) {
+            if (day >= 0) {
+                first = min(first, (int)day);
+                last = max(last, (int)day);
+            }
+        }
+        if (last < 0) return result;
+        const int32_t* date = dateColumn.data();
+        vector<double> sums = sumConfirmed((size_t)(last - first + 2), [&](size_t i) {
+            return date[i] < 0 ? 0 : date[i] - first + 1;
+        });
+        for (size_t i = 1; i < sums.size(); i++) {
+            if (sums[i] != 0.0) result.push_back(make_pair(first + (int)i - 1, sums[i]));
+        }
+        return result;
+    }
+};
+
+
+// Each passenger's confirmed bookings as arena handles ordered by booking
+// day, so listing or paging one passenger's trips costs time in their own
+// bookings rather than everyone's. Lists are indexed by passenger symbol.
+// Not synchronized: the owner updates and reads it under its records lock.
+class PassengerBookingIndex {
+public:
+    typedef RecordArena<Booking>::Handle Handle;
+
+private:
+    // (day + 2^31) << 32 | handle: by day, then in booking order.
+    vector<vector<uint64_t>> lists;
+
+    static uint64_t entryOf(int day, Handle handle) {
+        return (uint64_t)((int64_t)day - numeric_limits<int32_t>::min()) << 32 | handle;
+    }
+
+    const vector<uint64_t>* entries(uint32_t passenger) const {
+        return passenger < lists.size() ? &lists[passenger] : nullptr;
+    }
+
+public:
+    void add(uint32_t passenger, int day, Handle handle) {
+        if (passenger >= lists.size()) lists.resize(passenger + 1);
+        vector<uint64_t>& list = lists[passenger];
+        uint64_t entry = entryOf(day, handle);
+        if (list.empty() || list.back() < entry) list.push_back(entry);
+        else list.insert(upper_bound(list.begin(), list.end(), entry), entry);
+    }
+
+    void remove(uint32_t passenger, int day, Handle handle) {
+        if (passenger >= lists.size()) return;
+        vector<uint64_t>& list = lists[passenger];
+        uint64_t entry = entryOf(day, handle);
+        auto pos = lower_bound(list.begin(), list.end(), entry);
+        if (pos != list.end() && *pos == entry) list.erase(pos);
+    }
+
+    size_t count(uint32_t passenger) const {
+        const vector<uint64_t>* list = entries(passenger);
+        return list ? list->size() : 0;
+    }
+
+    // Handles of the bookings made on or after fromDay, skipping the first
+    // offset; total is how many there are in all.
+    vector<Handle> page(uint32_t passenger, int fromDay, size_t offset, size_t limit, size_t& total) const {
+        vector<Handle> result;
+        total = 0;
+        const vector<uint64_t>* list = entries(passenger);
+        if (!list) return result;
+        auto first = lower_bound(list->begin(), list->end(), entryOf(fromDay, 0));
+        total = (size_t)(list->end() - first);
+        if (offset >= total) return result;
+        size_t n = min(limit, total - offset);
+        result.reserve(n);
+        for (auto it = first + offset; it != first + offset + n; ++it) result.push_back((Handle)*it);
+        return result;
+    }
+
+    // All of the passenger's bookings in the order they were made.
+    vector<Handle> inBookingOrder(uint32_t passenger) const {
+        vector<Handle> result;
+        const vector<uint64_t>* list = entries(passenger);
+        if (!list) return result;
+        result.reserve(list->size());
+        for (uint64_t entry : *list) result.push_back((Handle)entry);
+        if (!is_sorted(result.begin(), result.end())) sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Loading: size the index for every symbol, then each thread reserves,
+    // appends to and finally sorts only the lists it owns.
+    void resize(size_t symbols) {
+        if (symbols > lists.size()) lists.resize(symbols);
+    }
+
+    void reserve(uint32_t passenger, size_t n) { lists[passenger].reserve(n); }
+
+    void append(uint32_t passenger, int day, Handle handle) {
+        lists[passenger].push_back(entryOf(day, handle));
+    }
+
+    void sortList(uint32_t passenger) {
+        vector<uint64_t>& list = lists[passenger];
+        if (!is_sorted(list.begin(), list.end())) sort(list.begin(), list.end());
+    }
+
+    void clear() { lists.clear(); }
+};
+
+
+class ReservationSystem {
+private:
+    // Append-only records live in arenas (admins, which are few, in a deque)
+    // and flights in a list, so handles and pointers held by the indexes and
+    // the session stay valid as they grow. Passenger and admin text is in
+    // textArena, freed with the system or by clearData().
+    TextArena textArena;
+    RecordArena<Passenger> passengers;
+    deque<Admin> admins;
+    list<Flight> flights;
+    RecordArena<Booking> bookings;
+    
+    PartitionedIndex<Passenger*> passengerIndex;
+    PartitionedIndex<Admin*> adminIndex;
+    PartitionedIndex<list<Flight>::iterator> flightIndex;
+    // getBookingKey() -> handle in bookings
+    PartitionedIndex<RecordArena<Booking>::Handle, int32_t,
+                     FlatIntMap<int32_t, RecordArena<Booking>::Handle>> bookingIndex;
+    FlightGraph flightGraph;
+    ReportAggregates aggregates;
+    BookingColumns bookingColumns;
+    PassengerBookingIndex passengerBookings;
+    
+    Passenger* currentPassenger;
+    Admin* currentAdmin;
+    
+    const string PASSENGERS_FILE;
+    const string ADMINS_FILE;
+    const string FLIGHTS_FILE;
+    const string BOOKINGS_FILE;
+    
+    const string SNAPSHOT_FILE;
+    
+    static constexpr size_t CHECKPOINT_INTERVAL = 1000;
+    Journal journal;
+    SnapshotFormat snapshotFormat;
+    
+    // Locking for the thread-safe API, always taken in this order:
+    //   catalogMutex  shared by every operation, exclusive for flight
+    //                 add/remove and checkpoints
+    //   flightLocks   striped by flight number; guards seats, booking status
+    //                 and the journal order of that flight's records
+    //   recordsMutex / holdsMutex / index partitions   short leaf sections;
+    //                 recordsMutex also guards booking status and
+    //                 passengerBookings
+    // What a snapshot writes, taken under the exclusive catalog lock.
+    // Admins and flights are few and copied; passengers and bookings are
+    // append-only, so the image keeps just their counts. The only change
+    // made in place, a cancellation, first saves the booking's original in
+    // `original` while the image is being written (copy-on-write).
+    struct SnapshotImage {
+        SnapshotFormat format;
+        vector<Admin> admins;
+        vector<Flight> flights;
+        size_t passengerCount;
+        size_t bookingCount;
+        unordered_map<RecordArena<Booking>::Handle, Booking> original;
+    };
+    
+    // The image's bookings, copied out a chunk at a time under recordsMutex.
+    class ImageBookings {
+    private:
+        static constexpr size_t CHUNK = 1024;
+        ReservationSystem& system;
+        const SnapshotImage& image;
+        
+    public:
+        class Iterator {
+        private:
+            const ImageBookings* owner;
+            size_t at;
+            vector<Booking> chunk;
+            
+            void fill() {
+                const SnapshotImage& image = owner->image;
+                size_t end = min(at + CHUNK, image.bookingCount);
+                chunk.clear();
+                lock_guard<mutex> records(owner->system.recordsMutex);
+                for (size_t h = at; h < end; h++) {
+                    auto saved = image.original.find((RecordArena<Booking>::Handle)h);
+                    chunk.push_back(saved != image.original.end() ? saved->second
+                                                                  : owner->system.bookings[(RecordArena<Booking>::Handle)h]);
+                }
+            }
+            
+        public:
+            Iterator(const ImageBookings* images, size_t start) : owner(images), at(start) {
+                if (at < owner->image.bookingCount) fill();
+            }
+            const Booking& operator*() const { return chunk[at % CHUNK]; }
+            Iterator& operator++() {
+                if (++at % CHUNK == 0 && at < owner->image.bookingCount) fill();
+                return *this;
+            }
+            bool operator!=(const Iterator& other) const { return at != other.at; }
+        };
+        
+        ImageBookings(ReservationSystem& owner, const SnapshotImage& snapshot) : system(owner), image(snapshot) {}
+        size_t size() const { return image.bookingCount; }
+        Iterator begin() const { return Iterator(this, 0); }
+        Iterator end() const { return Iterator(this, image.bookingCount); }
+    };
+    
+    struct SeatHold {
+        string flightNumber;
+        string seat;
+        uint64_t deadline;
+    };
+    
+    // Hold expiry runs on a TimerWheel ticking every HOLD_TICK_MS, advanced
+    // by a background thread that releases the seats of lapsed holds.
+    static constexpr int HOLD_TICK_MS = 100;
+    
+    static constexpr size_t FLIGHT_LOCK_STRIPES = 64;
+    mutable shared_mutex catalogMutex;
+    mutex flightLocks[FLIGHT_LOCK_STRIPES];
+    mutex recordsMutex;
+    mutex holdsMutex;
+    unordered_map<string, SeatHold> holds;
+    TimerWheel holdWheel;
+    
+    mutex reaperMutex;
+    condition_variable reaperWake;
+    bool reaperStopping;
+    thread holdReaper;
+    
+    // Background checkpoints: checkpoint() hands an image to the
+    // checkpointer thread. checkpointImage (guarded by recordsMutex) is the
+    // image being written; the rest is guarded by checkpointerMutex.
+    // checkpointBusy is set from when a checkpoint or saveAllData() claims
+    // the snapshot files, before it takes the catalog lock, until they are
+    // written; it is atomic so maybeCheckpoint() can skip without locking.
+    mutex checkpointerMutex;
+    condition_variable checkpointerWake;
+    condition_variable checkpointerIdle;
+    unique_ptr<SnapshotImage> pendingImage;
+    SnapshotImage* checkpointImage;
+    atomic<bool> checkpointBusy;
+    bool checkpointerStopping;
+    thread checkpointer;
+    
+    // Lock-free read side (see FlightCatalog). slotOf maps each live flight
+    // to its slot and changes only under the exclusive catalog lock; slots
+    // of erased flights wait in erasedSlots until the next publishCatalog().
+    atomic<const FlightCatalog*> flightCatalog;
+    unordered_map<const Flight*, FlightSlot*> slotOf;
+    vector<FlightSlot*> erasedSlots;
+
+public:
+    static constexpr int DEFAULT_HOLD_TTL_SECONDS = 300;
+    
+    // Data files live in dataDir (the working directory when empty); an
+    // empty system is seeded with the sample admin and flights unless
+    // sampleData is false.
+    explicit ReservationSystem(const string& dataDir = "", bool sampleData = true)
+        : currentPassenger(nullptr), currentAdmin(nullptr),
+          PASSENGERS_FILE(dataPath(dataDir, "passengers.txt")), ADMINS_FILE(dataPath(dataDir, "admins.txt")),
+          FLIGHTS_FILE(dataPath(dataDir, "flights.txt")), BOOKINGS_FILE(dataPath(dataDir, "bookings.txt")),
+          SNAPSHOT_FILE(dataPath(dataDir, "snapshot.bin")), journal(dataPath(dataDir, "journal.log")),
+          snapshotFormat(SnapshotFormat::Text), holdWheel(holdTick()),
+          reaperStopping(false), checkpointImage(nullptr),
+          checkpointBusy(false), checkpointerStopping(false), flightCatalog(new FlightCatalog()) {
+        loadAllData();
+        if (sampleData) initializeSampleData();
+        holdReaper = thread(&ReservationSystem::runHoldReaper, this);
+        checkpointer = thread(&ReservationSystem::runCheckpointer, this);
+    }
+    
+    ~ReservationSystem() {
+        {
+            lock_guard<mutex> guard(reaperMutex);
+            reaperStopping = true;
+        }
+        reaperWake.notify_one();
+        holdReaper.join();
+        {
+            lock_guard<mutex> guard(checkpointerMutex);
+            checkpointerStopping = true;
+        }
+        checkpointerWake.notify_one();
+        checkpointer.join();
+        saveAllData();
+        delete flightCatalog.load();
+        for (auto& slot : slotOf) delete slot.second;
+        for (FlightSlot* slot : erasedSlots) delete slot;
+    }
+    
+    static string dataPath(const string& dataDir, const string& name) {
+        return dataDir.empty() ? name : dataDir + "/" + name;
+    }
+    
+    void initializeSampleData() {
+        TextArena::Use use(textArena);
+        bool seeded = admins.empty() || flights.empty();
+
+        if (admins.empty()) {
+            insertAdmin(Admin("admin", "admin123", "System Admin", "admin@airline.com", "SUPER"));
+        }
+
+        if (flights.empty()) {
+            insertFlight(Flight("AI101", "Air India", "New Delhi", "Mumbai", 
+                                "15/10/2025", "08:00", "10:30", 48, 5500.00));
+            insertFlight(Flight("AI102", "Air India", "Mumbai", "Bangalore", 
+                                "15/10/2025", "11:00", "13:30", 48, 4200.00));
+            insertFlight(Flight("SG201", "SpiceJet", "Bangalore", "Chennai", 
+                                "16/10/2025", "14:00", "15:30", 42, 3800.00));
+            insertFlight(Flight("IG301", "IndiGo", "Chennai", "Kolkata", 
+                                "16/10/2025", "17:00", "19:30", 54, 6500.00));
+            insertFlight(Flight("AI103", "Air India", "Delhi", "Goa", 
+                                "17/10/2025", "07:00", "09:30", 36, 7200.00));
+        }
+        
+        if (seeded) {
+            publishCatalog();
+            saveAllData();
+        }
+    }
+    
+
+    Passenger* findPassenger(const string& userId) {
+        Passenger** p = passengerIndex.find(userId);
+        return p ? *p : nullptr;
+    }
+    
+    Admin* findAdmin(const string& userId) {
+        Admin** a = adminIndex.find(userId);
+        return a ? *a : nullptr;
+    }
+    
+    Flight* findFlight(const string& flightNumber) {
+        list<Flight>::iterator* it = flightIndex.find(flightNumber);
+        return it ? &**it : nullptr;
+    }
+    
+    bool findBookingHandle(const string& bookingId, RecordArena<Booking>::Handle& handle) {
+        int32_t key;
+        return lookupBookingId(bookingId, key) && bookingIndex.get(key, handle);
+    }
+    
+    Booking* findBooking(const string& bookingId) {
+        RecordArena<Booking>::Handle handle;
+        return findBookingHandle(bookingId, handle) ? &bookings[handle] : nullptr;
+    }
+    
+    Passenger* insertPassenger(Passenger p) {
+        Passenger* stored = &passengers[passengers.push_back(move(p))];
+        passengerIndex.set(stored->getUserId(), stored);
+        reserveId(stored->getUserId());
+        return stored;
+    }
+    
+    Admin* insertAdmin(Admin a) {
+        admins.push_back(move(a));
+        Admin* stored = &admins.back();
+        adminIndex.set(stored->getUserId(), stored);
+        reserveId(stored->getUserId());
+        return stored;
+    }
+    
+    Flight* insertFlight(Flight f) {
+        auto it = flights.insert(flights.end(), move(f));
+        flightIndex.set(it->getFlightNumber(), it);
+        flightGraph.insert(&*it);
+        aggregates.flightAdded(*it);
+        bookingColumns.describeFlight(*it);
+        return &*it;
+    }
+    
+    bool eraseFlight(const string& flightNumber) {
+        list<Flight>::iterator* it = flightIndex.find(flightNumber);
+        if (!it) return false;
+        flightGraph.erase(&**it);
+        aggregates.flightRemoved((*it)->getFlightSymbol());
+        auto slot = slotOf.find(&**it);
+        if (slot != slotOf.end()) {
+            erasedSlots.push_back(slot->second);
+            slotOf.erase(slot);
+        }
+        flights.erase(*it);
+        flightIndex.erase(flightNumber);
+        return true;
+    }
+    
+    RecordArena<Booking>::Handle insertBooking(Booking b) {
+        RecordArena<Booking>::Handle handle = bookings.push_back(move(b));
+        const Booking& stored = bookings[handle];
+        bookingIndex.set(stored.getBookingKey(), handle);
+        reserveBookingKey(stored.getBookingKey());
+        return handle;
+    }
+    
+
+    SnapshotFormat getSnapshotFormat() const { return snapshotFormat; }
+    
+    void setSnapshotFormat(SnapshotFormat format) { snapshotFormat = format; }
+    
+    // See Journal::setCommitWindow.
+    void setCommitWindow(chrono::microseconds window) { journal.setCommitWindow(window); }
+    
+    // While a DeferredSync for a system is alive on a thread, that system's
+    // operations on the thread return once their journal records are
+    // queued, without waiting for the fsync. The caller then passes
+    // sequence() to syncJournal() from whichever thread answers the client,
+    // so a worker running many callers' operations never waits on disk.
+    class DeferredSync {
+    private:
+        const ReservationSystem* system;
+        uint64_t seq;
+        DeferredSync* previous;
+        
+        static DeferredSync*& innermost() {
+            thread_local DeferredSync* scope = nullptr;
+            return scope;
+        }
+        
+        friend class ReservationSystem;
+        
+    public:
+        explicit DeferredSync(const ReservationSystem& system)
+            : system(&system), seq(0), previous(innermost()) {
+            innermost() = this;
+        }
+        ~DeferredSync() { innermost() = previous; }
+        DeferredSync(const DeferredSync&) = delete;
+        DeferredSync& operator=(const DeferredSync&) = delete;
+        
+        uint64_t sequence() const { return seq; }
+    };
+    
+    // Waits until everything up to seq is on disk; false when it could not
+    // be saved (see journalSync).
+    bool syncJournal(uint64_t seq) {
+        bool saved = journalSync(seq);
+        maybeCheckpoint();
+        return saved;
+    }
+    
+    static constexpr const char* UNSAVED_ERROR = "Change made but could not be saved to disk!";
+    
+    // Turns a successful result into a failure for a change that was applied
+    // but could not be saved.
+    template <typename Result>
+    static void markUnsaved(Result& result) {
+        result.success = false;
+        result.error = UNSAVED_ERROR;
+    }
+    
+    static void markUnsaved(bool& saved) { saved = false; }
+    
+    // Writes a full snapshot in the foreground, after any background
+    // checkpoint has finished, and empties the journal. Returns whether the
+    // snapshot was written.
+    bool saveAllData() {
+        claimSnapshot(true);
+        bool saved;
+        {
+            unique_lock<shared_mutex> catalog(catalogMutex);
+            saved = writeSnapshot(*captureImage());
+            if (saved) journal.reset();
+        }
+        releaseSnapshot();
+        return saved;
+    }
+    
+    // Loads snapshot.bin when present (and keeps saving in that format),
+    // otherwise the four text files: all parsed concurrently, large ones in
+    // chunks. Records are appended in file order, indexed and reconciled.
+    void loadAllData() {
+        ARS_TIME_SCOPE(Timer::Load);
+        TextArena::Use use(textArena);
+        unsigned threads = workerThreads();
+        vector<Passenger> loadedPassengers;
+        vector<Admin> loadedAdmins;
+        vector<Flight> loadedFlights;
+        vector<Booking> loadedBookings;
+        
+        if (ifstream(SNAPSHOT_FILE).good()) {
+            snapshotFormat = SnapshotFormat::Binary;
+            BinarySnapshot::load(SNAPSHOT_FILE, loadedPassengers, loadedAdmins,
+                                 loadedFlights, loadedBookings, threads);
+        } else {
+            auto passengerTask = async(launch::async, parseRecordsParallel<Passenger>, PASSENGERS_FILE,
+                                       threads, ref(textArena));
+            auto adminTask = async(launch::async, parseRecordsParallel<Admin>, ADMINS_FILE, 1u, ref(textArena));
+            auto flightTask = async(launch::async, parseRecordsParallel<Flight>, FLIGHTS_FILE,
+                                    threads, ref(textArena));
+            loadedBookings = parseRecordsParallel<Booking>(BOOKINGS_FILE, threads, textArena);
+            loadedPassengers = passengerTask.get();
+            loadedAdmins = adminTask.get();
+            loadedFlights = flightTask.get();
+        }
+        
+        size_t passengersFrom = passengers.size();
+        for (auto& p : loadedPassengers) {
+            reserveId(p.getUserId());
+            passengers.push_back(move(p));
+        }
+        loadedPassengers = vector<Passenger>();
+        for (auto& a : loadedAdmins) insertAdmin(move(a));
+        for (auto& f : loadedFlights) insertFlight(move(f));
+        size_t bookingsFrom = bookings.size();
+        for (auto& b : loadedBookings) {
+            reserveBookingKey(b.getBookingKey());
+            bookings.push_back(move(b));
+        }
+        loadedBookings = vector<Booking>();
+        
+        passengerIndex.bulkInsert(passengers, passengersFrom,
+            [](const Passenger& p) { return p.getUserId(); },
+            [](Passenger& p, size_t) { return &p; }, threads);
+        bookingIndex.bulkInsert(bookings, bookingsFrom,
+            [](const Booking& b) { return b.getBookingKey(); },
+            [](Booking&, size_t handle) { return (RecordArena<Booking>::Handle)handle; }, threads);
+        
+        reconcileLoadedData(threads);
+        replayJournal();
+        publishCatalog();
+        aggregates.rebuild(flights, bookings);
+    }
+    
+    // Publishes a new FlightCatalog after flights were loaded or cleared.
+    // Caller holds the catalog lock exclusively (or is loading). Slots carry
+    // over for flights that remain; new flights get one holding a copy of
+    // their current seats, and slots of removed flights are retired.
+    void publishCatalog() {
+        EpochDomain& epochs = EpochDomain::instance();
+        FlightCatalog* next = new FlightCatalog();
+        unordered_map<const Flight*, FlightSlot*> slots;
+        unordered_map<RouteKey, vector<pair<string, const FlightSlot*>>, RouteKeyHash> routes;
+        next->all.reserve(flights.size());
+        for (const auto& f : flights) {
+            auto it = slotOf.find(&f);
+            FlightSlot* slot = it != slotOf.end() ? it->second : new FlightSlot(f);
+            if (it != slotOf.end()) slotOf.erase(it);
+            slots.emplace(&f, slot);
+            next->all.push_back(slot);
+            next->byNumber.emplace(f.getFlightSymbol(), slot);
+            routes[FlightCatalog::routeOf(f)].emplace_back(f.getDepartureTime(), slot);
+        }
+        for (auto& route : routes) {
+            vector<pair<string, const FlightSlot*>>& timed = route.second;
+            stable_sort(timed.begin(), timed.end(), [](const pair<string, const FlightSlot*>& a,
+                                                       const pair<string, const FlightSlot*>& b) {
+                return a.first < b.first;
+            });
+            auto sorted = make_shared<FlightCatalog::Route>();
+            sorted->reserve(timed.size());
+            for (const auto& entry : timed) sorted->push_back(entry.second);
+            next->byRoute.emplace(route.first, move(sorted));
+        }
+        for (auto& removed : slotOf) epochs.retire(removed.second);
+        for (FlightSlot* removed : erasedSlots) epochs.retire(removed);
+        erasedSlots.clear();
+        slotOf.swap(slots);
+        epochs.retire(flightCatalog.exchange(next));
+    }
+    
+    // Publishes the catalog with f, just inserted, added. Only the list of
+    // f's route is copied; the other routes are shared with the old catalog.
+    void publishFlightAdded(const Flight& f) {
+        const FlightCatalog* current = flightCatalog.load(memory_order_relaxed);
+        FlightCatalog* next = new FlightCatalog(*current);
+        FlightSlot* slot = new FlightSlot(f);
+        slotOf.emplace(&f, slot);
+        next->all.push_back(slot);
+        next->byNumber.emplace(f.getFlightSymbol(), slot);
+        shared_ptr<const FlightCatalog::Route>& route = next->byRoute[FlightCatalog::routeOf(f)];
+        auto updated = route ? make_shared<FlightCatalog::Route>(*route) : make_shared<FlightCatalog::Route>();
+        string departure = f.getDepartureTime();
+        auto at = upper_bound(updated->begin(), updated->end(), departure,
+                              [](const string& time, const FlightSlot* other) {
+                                  return time < other->view.load(memory_order_relaxed)->getDepartureTime();
+                              });
+        updated->insert(at, slot);
+        route = move(updated);
+        EpochDomain::instance().retire(flightCatalog.exchange(next));
+    }
+    
+    // Publishes the catalog without the flights eraseFlight() just removed,
+    // copying only their routes' lists, and retires their slots.
+    void publishFlightsErased() {
+        EpochDomain& epochs = EpochDomain::instance();
+        const FlightCatalog* current = flightCatalog.load(memory_order_relaxed);
+        FlightCatalog* next = new FlightCatalog(*current);
+        for (FlightSlot* slot : erasedSlots) {
+            const Flight* f = slot->view.load(memory_order_relaxed);
+            next->all.erase(find(next->all.begin(), next->all.end(), slot));
+            next->byNumber.erase(f->getFlightSymbol());
+            auto route = next->byRoute.find(FlightCatalog::routeOf(*f));
+            auto updated = make_shared<FlightCatalog::Route>(*route->second);
+            updated->erase(find(updated->begin(), updated->end(), slot));
+            if (updated->empty()) next->byRoute.erase(route);
+            else route->second = move(updated);
+        }
+        epochs.retire(flightCatalog.exchange(next));
+        for (FlightSlot* removed : erasedSlots) epochs.retire(removed);
+        erasedSlots.clear();
+    }
+    
+    // Published copy of a live flight; caller holds the catalog lock and an
+    // EpochGuard.
+    const Flight* viewOf(const Flight* f) const {
+        return slotOf.find(f)->second->view.load(memory_order_acquire);
+    }
+    
+    // Caller holds the flight's lock; readers see the new seats from here on.
+    void seatsChanged(const Flight& f) {
+        auto it = slotOf.find(&f);
+        if (it == slotOf.end()) return;
+        EpochDomain::instance().retire(it->second->view.exchange(new Flight(f)));
+    }
+    
+    // Cross-file fixups: every confirmed booking holds its seat and is listed
+    // under its passenger. Work is split by index partition so no two threads
+    // touch the same record.
+    void reconcileLoadedData(unsigned threads) {
+        threads = max(threads, 1u);
+        size_t symbols = SymbolTable::instance().size();
+        vector<uint32_t> perPassenger(symbols, 0);
+        passengerBookings.clear();
+        passengerBookings.resize(symbols);
+        runParallel(threads, [&](unsigned t) {
+            for (const auto& b : bookings) {
+                if (b.isConfirmed() && b.getPassengerSymbol() % threads == t) perPassenger[b.getPassengerSymbol()]++;
+            }
+            for (uint32_t p = t; p < symbols; p += threads) {
+                if (perPassenger[p]) passengerBookings.reserve(p, perPassenger[p]);
+            }
+            for (size_t i = 0; i < bookings.size(); i++) {
+                const Booking& b = bookings[(RecordArena<Booking>::Handle)i];
+                if (!b.isConfirmed()) continue;
+                if (b.getPassengerSymbol() % threads == t && findPassenger(b.getPassengerId())) {
+                    passengerBookings.append(b.getPassengerSymbol(), b.getBookingDay(),
+                                             (RecordArena<Booking>::Handle)i);
+                }
+                if (PartitionedIndex<list<Flight>::iterator>::partitionOf(b.getFlightNumber()) % threads == t) {
+                    Flight* f = findFlight(b.getFlightNumber());
+                    if (f) f->bookSeat(b.getSeatNumber());
+                }
+            }
+            for (uint32_t p = t; p < symbols; p += threads) {
+                if (perPassenger[p]) passengerBookings.sortList(p);
+            }
+        });
+    }
+    
+    // Queues the records; whether they reached the disk is journalSync()'s
+    // to find out.
+    void journalWrite(const string& record, uint64_t& seq) {
+        journal.write(vector<string>(1, record), seq);
+    }
+    
+    void journalWrite(const vector<string>& records, uint64_t& seq) {
+        journal.write(records, seq);
+    }
+    
+    // Waits for the persistence thread, so call it after releasing the
+    // locks: records queued by many callers then share one fsync. When the
+    // journal could not write them, a full snapshot is written before
+    // returning instead; false means neither reached the disk. Under a
+    // DeferredSync the wait is left to its owner.
+    bool journalSync(uint64_t seq) {
+        for (DeferredSync* deferred = DeferredSync::innermost(); deferred; deferred = deferred->previous) {
+            if (deferred->system == this) {
+                deferred->seq = max(deferred->seq, seq);
+                return true;
+            }
+        }
+        return !seq || journal.sync(seq) || saveAllData();
+    }
+    
+    // Finishes a change whose records were queued up to seq. A change that
+    // could not be saved stays applied in memory but is reported as failed.
+    template <typename Result>
+    Result settle(Result result, uint64_t seq) {
+        if (!syncJournal(seq)) markUnsaved(result);
+        return result;
+    }
+    
+    bool checkpointDue() const {
+        return journal.size() >= CHECKPOINT_INTERVAL;
+    }
+    
+    // Must be called without holding catalogMutex. One caller checkpoints;
+    // the rest carry on rather than queueing up to repeat it.
+    void maybeCheckpoint() {
+        if (checkpointDue() && !checkpointBusy.load(memory_order_relaxed)) checkpoint();
+    }
+    
+    // Pauses writers only to take the image and rotate the journal; the
+    // checkpointer thread writes the snapshot while bookings carry on. At
+    // most one runs at a time, and a caller that finds one running returns
+    // before touching the catalog lock.
+    void checkpoint() {
+        if (!claimSnapshot(false)) return;
+        ARS_TIME_SCOPE(Timer::Checkpoint);
+        unique_lock<shared_mutex> catalog(catalogMutex);
+        if (!checkpointDue()) {
+            catalog.unlock();
+            releaseSnapshot();
+            return;
+        }
+        unique_ptr<SnapshotImage> image = captureImage();
+        journal.rotate();
+        {
+            lock_guard<mutex> records(recordsMutex);
+            checkpointImage = image.get();
+        }
+        {
+            lock_guard<mutex> guard(checkpointerMutex);
+            pendingImage = move(image);
+        }
+        checkpointerWake.notify_one();
+    }
+    
+    // Sets checkpointBusy, waiting for the running checkpoint when wait is
+    // set and giving up otherwise. Call without holding catalogMutex.
+    bool claimSnapshot(bool wait) {
+        unique_lock<mutex> guard(checkpointerMutex);
+        if (wait) checkpointerIdle.wait(guard, [this]() { return !checkpointBusy; });
+        else if (checkpointBusy) return false;
+        checkpointBusy = true;
+        return true;
+    }
+    
+    void releaseSnapshot() {
+        {
+            lock_guard<mutex> guard(checkpointerMutex);
+            checkpointBusy = false;
+        }
+        checkpointerIdle.notify_all();
+    }
+    
+    void runCheckpointer() {
+        unique_lock<mutex> guard(checkpointerMutex);
+        while (true) {
+            checkpointerWake.wait(guard, [this]() { return checkpointerStopping || pendingImage; });
+            if (!pendingImage) return;
+            unique_ptr<SnapshotImage> image = move(pendingImage);
+            guard.unlock();
+            
+            // The rotated log is kept (and replayed) until the snapshot
+            // files hold everything in it.
+            bool ok = journal.awaitRotation() && writeSnapshot(*image);
+            if (ok) journal.discardRotated();
+            {
+                lock_guard<mutex> records(recordsMutex);
+                checkpointImage = nullptr;
+            }
+            image.reset();
+            
+            releaseSnapshot();
+            guard.lock();
+        }
+    }
+    
+    void waitForCheckpoint() {
+        unique_lock<mutex> guard(checkpointerMutex);
+        checkpointerIdle.wait(guard, [this]() { return !checkpointBusy; });
+    }
+    
+    // Call under the exclusive catalog lock.
+    unique_ptr<SnapshotImage> captureImage() const {
+        unique_ptr<SnapshotImage> image(new SnapshotImage());
+        image->format = snapshotFormat;
+        image->admins.assign(admins.begin(), admins.end());
+        image->flights.assign(flights.begin(), flights.end());
+        image->passengerCount = passengers.size();
+        image->bookingCount = bookings.size();
+        return image;
+    }
+    
+    // Every file is replaced atomically. flights.txt goes before
+    // bookings.txt: new flights with old bookings replay cleanly, while old
+    // flights with new bookings would leave cancelled seats taken.
+    bool writeSnapshot(const SnapshotImage& image) {
+        ARS_TIME_SCOPE(Timer::Save);
+        ImageBookings imageBookings(*this, image);
+        if (image.format == SnapshotFormat::Binary) {
+            return BinarySnapshot::save(SNAPSHOT_FILE, passengers.prefix(image.passengerCount),
+                                        image.admins, image.flights, imageBookings);
+        }
+        bool ok = savePassengers(image, imageBookings) && saveAdmins(image) &&
+                  saveFlights(image) && saveBookings(imageBookings);
+        if (ok) remove(SNAPSHOT_FILE.c_str());
+        return ok;
+    }
+    
+    mutex& flightLock(const string& flightNumber) {
+        return flightLocks[hash<string>()(flightNumber) % FLIGHT_LOCK_STRIPES];
+    }
+    
+    // Caller holds the flight's lock and has already taken the seat.
+    Booking commitBooking(Passenger& p, const Flight& f, int seatIndex, uint64_t& seq) {
+        Booking b = recordBooking(p, f, seatIndex);
+        journalWrite("B|" + b.toFileString(), seq);
+        return b;
+    }
+    
+    // commitBooking without the journal write.
+    Booking recordBooking(Passenger& p, const Flight& f, int seatIndex) {
+        Booking b(generateId("TXN"), p.getUserId(), f.getFlightNumber(),
+                  SeatInventory::formatSeat(seatIndex), f.getBaseFare());
+        {
+            lock_guard<mutex> records(recordsMutex);
+            passengerBookings.add(b.getPassengerSymbol(), b.getBookingDay(), insertBooking(b));
+            bookingColumns.append(b);
+        }
+        aggregates.booked(b.getFlightSymbol(), b.getTotalFare());
+        ARS_COUNT(Counter::SeatsBooked, 1);
+        return b;
+    }
+    
+public:
+    // Thread-safe booking API. Operations on different flights only share
+    // the brief leaf locks; a seat can never be booked twice because the
+    // check-and-take happens under the flight's lock.
+    BookingResult book(const string& passengerId, const string& flightNumber, const string& seat) {
+        ARS_TIME_SCOPE(Timer::Book);
+        int index = SeatInventory::parseSeat(seat);
+        return placeBooking(passengerId, flightNumber, "Seat not available!",
+                            [index](const Flight&) { return index; });
+    }
+    
+    // Books the seat that best matches the preference (see SeatInventory::pick).
+    // Choosing and taking happen under the flight's lock, so concurrent
+    // auto-assignments never collide.
+    BookingResult autoBook(const string& passengerId, const string& flightNumber,
+                           const SeatPreference& preference = SeatPreference()) {
+        ARS_TIME_SCOPE(Timer::Book);
+        return placeBooking(passengerId, flightNumber, "No seats available!",
+                            [&preference](const Flight& f) { return f.pickSeat(preference); });
+    }
+    
+private:
+    template <typename Pick>
+    BookingResult placeBooking(const string& passengerId, const string& flightNumber,
+                               const char* unavailable, Pick pick) {
+        BookingResult result = {false, "", Booking()};
+        uint64_t seq = 0;
+        {
+            shared_lock<shared_mutex> catalog(catalogMutex);
+            Passenger* p = findPassenger(passengerId);
+            Flight* f = findFlight(flightNumber);
+            if (!p) {
+                result.error = "Passenger not found!";
+                return result;
+            }
+            if (!f) {
+                result.error = "Flight not found!";
+                return result;
+            }
+            {
+                lock_guard<mutex> flightGuard(flightLock(flightNumber));
+                int index = pick(*f);
+                if (!f->bookSeatAt(index)) {
+                    result.error = unavailable;
+                    return result;
+                }
+                seatsChanged(*f);
+                result.booking = commitBooking(*p, *f, index, seq);
+                result.success = true;
+            }
+        }
+        return settle(result, seq);
+    }
+    
+public:
+    
+    // Cancels a confirmed booking; when passengerId is given the booking
+    // must belong to that passenger.
+    BookingResult cancel(const string& bookingId, const string& passengerId = "") {
+        ARS_TIME_SCOPE(Timer::Cancel);
+        BookingResult result = {false, "Booking not found or already cancelled!", Booking()};
+        uint64_t seq = 0;
+        {
+            shared_lock<shared_mutex> catalog(catalogMutex);
+            RecordArena<Booking>::Handle handle;
+            if (!findBookingHandle(bookingId, handle)) return result;
+            Booking* b = &bookings[handle];
+            if (!passengerId.empty() && b->getPassengerId() != passengerId) return result;
+            {
+                lock_guard<mutex> flightGuard(flightLock(b->getFlightNumber()));
+                if (!b->isConfirmed()) return result;
+                
+                Flight* f = findFlight(b->getFlightNumber());
+                if (f) {
+                    f->cancelSeat(b->getSeatNumber());
+                    seatsChanged(*f);
+                }
+                {
+                    lock_guard<mutex> records(recordsMutex);
+                    if (checkpointImage && handle < checkpointImage->bookingCount) {
+                        checkpointImage->original.emplace(handle, *b);
+                    }
+                    b->setStatus("CANCELLED");
+                    passengerBookings.remove(b->getPassengerSymbol(), b->getBookingDay(), handle);
+                    bookingColumns.setStatus(b->getBookingKey(), BookingColumns::CANCELLED);
+                }
+                aggregates.cancelled(b->getFlightSymbol(), b->getTotalFare());
+                ARS_COUNT(Counter::SeatsCancelled, 1);
+                journalWrite("C|" + bookingId, seq);
+                result.booking = *b;
+                result.success = true;
+                result.error = "";
+            }
+        }
+        return settle(result, seq);
+    }
+    
+    // Books every seat of every leg for one passenger, or nothing. All the
+    // flights involved are locked together (stripes in index order, so two
+    // batches cannot deadlock), seats are picked as adjacent blocks, and the
+    // whole batch goes to the journal as one group with a single fsync.
+    BatchBookingResult bookBatch(const string& passengerId, const vector<BatchLeg>& legs) {
+        ARS_TIME_SCOPE(Timer::BookBatch);
+        BatchBookingResult result = {false, "", {}};
+        uint64_t seq = 0;
+        {
+            shared_lock<shared_mutex> catalog(catalogMutex);
+            Passenger* p = findPassenger(passengerId);
+            if (!p) {
+                result.error = "Passenger not found!";
+                return result;
+            }
+            if (legs.empty()) {
+                result.error = "No seats requested!";
+                return result;
+            }
+            
+            vector<Flight*> legFlights;
+            vector<size_t> stripes;
+            for (const BatchLeg& leg : legs) {
+                Flight* f = findFlight(leg.flightNumber);
+                if (!f) {
+                    result.error = "Flight " + leg.flightNumber + " not found!";
+                    return result;
+                }
+                if (leg.seats.empty() && leg.seatCount <= 0) {
+                    result.error = "Invalid seat count for flight " + leg.flightNumber + "!";
+                    return result;
+                }
+                legFlights.push_back(f);
+                stripes.push_back(hash<string>()(leg.flightNumber) % FLIGHT_LOCK_STRIPES);
+            }
+            sort(stripes.begin(), stripes.end());
+            stripes.erase(unique(stripes.begin(), stripes.end()), stripes.end());
+            vector<unique_lock<mutex>> flightGuards;
+            for (size_t stripe : stripes) flightGuards.emplace_back(flightLocks[stripe]);
+            
+            // Take the seats leg by leg, giving everything back on the first failure.
+            vector<pair<Flight*, int>> taken;
+            for (size_t i = 0; i < legs.size() && result.error.empty(); i++) {
+                Flight* f = legFlights[i];
+                vector<int> picked;
+                if (legs[i].seats.empty()) {
+                    picked = f->findSeatBlock(legs[i].seatCount);
+                    if (picked.empty()) result.error = "Not enough seats on flight " + f->getFlightNumber() + "!";
+                } else {
+                    for (const string& seat : legs[i].seats) picked.push_back(SeatInventory::parseSeat(seat));
+                }
+                for (size_t k = 0; k < picked.size() && result.error.empty(); k++) {
+                    if (f->bookSeatAt(picked[k])) {
+                        taken.push_back({f, picked[k]});
+                    } else {
+                        string seat = legs[i].seats.empty() ? SeatInventory::formatSeat(picked[k]) : legs[i].seats[k];
+                        result.error = "Seat " + seat + " not available on flight " + f->getFlightNumber() + "!";
+                    }
+                }
+            }
+            if (!result.error.empty()) {
+                for (const auto& seat : taken) seat.first->cancelSeatAt(seat.second);
+                return result;
+            }
+            
+            vector<string> records;
+            records.reserve(taken.size());
+            result.bookings.reserve(taken.size());
+            for (const auto& seat : taken) {
+                result.bookings.push_back(recordBooking(*p, *seat.first, seat.second));
+                records.push_back("B|" + result.bookings.back().toFileString());
+            }
+            sort(legFlights.begin(), legFlights.end());
+            legFlights.erase(unique(legFlights.begin(), legFlights.end()), legFlights.end());
+            for (Flight* f : legFlights) seatsChanged(*f);
+            journalWrite(records, seq);
+            result.success = true;
+        }
+        return settle(result, seq);
+    }
+    
+    // Holds are in-memory reservations: they block the seat for other
+    // bookers until confirmed, released or ttlSeconds pass, are not
+    // journaled and disappear on restart.
+    HoldResult hold(const string& flightNumber, const string& seat, int ttlSeconds = DEFAULT_HOLD_TTL_SECONDS) {
+        ARS_TIME_SCOPE(Timer::Hold);
+        int index = SeatInventory::parseSeat(seat);
+        return placeHold(flightNumber, ttlSeconds, "Seat not available!",
+                         [index](const Flight&) { return index; });
+    }
+    
+    // Holds an auto-assigned seat; HoldResult::seat says which one.
+    HoldResult hold(const string& flightNumber, const SeatPreference& preference,
+                    int ttlSeconds = DEFAULT_HOLD_TTL_SECONDS) {
+        ARS_TIME_SCOPE(Timer::Hold);
+        return placeHold(flightNumber, ttlSeconds, "No seats available!",
+                         [&preference](const Flight& f) { return f.pickSeat(preference); });
+    }
+    
+private:
+    template <typename Pick>
+    HoldResult placeHold(const string& flightNumber, int ttlSeconds, const char* unavailable, Pick pick) {
+        HoldResult result = {false, "", "", ""};
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        Flight* f = findFlight(flightNumber);
+        if (!f) {
+            result.error = "Flight not found!";
+            return result;
+        }
+        {
+            lock_guard<mutex> flightGuard(flightLock(flightNumber));
+            int index = pick(*f);
+            if (!f->holdSeatAt(index)) {
+                result.error = unavailable;
+                return result;
+            }
+            seatsChanged(*f);
+            result.seat = SeatInventory::formatSeat(index);
+        }
+        result.holdId = generateId("HLD");
+        result.success = true;
+        uint64_t deadline = holdTick() + (uint64_t)max(ttlSeconds, 0) * 1000 / HOLD_TICK_MS;
+        lock_guard<mutex> holdGuard(holdsMutex);
+        holds[result.holdId] = SeatHold{flightNumber, result.seat, deadline};
+        holdWheel.schedule(result.holdId, deadline);
+        return result;
+    }
+    
+public:
+    
+    bool releaseHold(const string& holdId) {
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        SeatHold seatHold;
+        if (!takeHold(holdId, seatHold)) return false;
+        Flight* f = findFlight(seatHold.flightNumber);
+        if (!f) return false;
+        lock_guard<mutex> flightGuard(flightLock(seatHold.flightNumber));
+        if (!f->releaseHeldSeat(seatHold.seat)) return false;
+        seatsChanged(*f);
+        return true;
+    }
+    
+    BookingResult confirmHold(const string& holdId, const string& passengerId) {
+        BookingResult result = {false, "", Booking()};
+        uint64_t seq = 0;
+        {
+            shared_lock<shared_mutex> catalog(catalogMutex);
+            Passenger* p = findPassenger(passengerId);
+            if (!p) {
+                result.error = "Passenger not found!";
+                return result;
+            }
+            SeatHold seatHold;
+            Flight* f = takeHold(holdId, seatHold) ? findFlight(seatHold.flightNumber) : nullptr;
+            if (!f) {
+                result.error = "Hold not found or expired!";
+                return result;
+            }
+            {
+                lock_guard<mutex> flightGuard(flightLock(seatHold.flightNumber));
+                if (!f->bookHeldSeat(seatHold.seat)) {
+                    result.error = "Hold not found or expired!";
+                    return result;
+                }
+                seatsChanged(*f);
+                result.booking = commitBooking(*p, *f, SeatInventory::parseSeat(seatHold.seat), seq);
+                result.success = true;
+            }
+        }
+        return settle(result, seq);
+    }
+    
+    // Releases the seats of every hold past its deadline; returns how many.
+    size_t expireHolds() {
+        vector<SeatHold> expired;
+        {
+            lock_guard<mutex> holdGuard(holdsMutex);
+            holdWheel.advance(holdTick(), [&](const string& holdId) {
+                auto it = holds.find(holdId);
+                if (it == holds.end()) return;  // already confirmed or released
+                expired.push_back(move(it->second));
+                holds.erase(it);
+            });
+        }
+        if (expired.empty()) return 0;
+        
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        for (const SeatHold& seatHold : expired) {
+            Flight* f = findFlight(seatHold.flightNumber);
+            if (!f) continue;
+            lock_guard<mutex> flightGuard(flightLock(seatHold.flightNumber));
+            if (f->releaseHeldSeat(seatHold.seat)) seatsChanged(*f);
+        }
+        ARS_COUNT(Counter::HoldsExpired, expired.size());
+        return expired.size();
+    }
+    
+    size_t activeHolds() {
+        lock_guard<mutex> holdGuard(holdsMutex);
+        return holds.size();
+    }
+    
+private:
+    static uint64_t holdTick() {
+        return (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+                   chrono::steady_clock::now().time_since_epoch()).count() / HOLD_TICK_MS;
+    }
+    
+    void runHoldReaper() {
+        unique_lock<mutex> guard(reaperMutex);
+        while (!reaperStopping) {
+            reaperWake.wait_for(guard, chrono::milliseconds(HOLD_TICK_MS));
+            if (reaperStopping) break;
+            guard.unlock();
+            expireHolds();
+            guard.lock();
+        }
+    }
+    
+    // A hold past its deadline is left for expireHolds, which also frees the seat.
+    bool takeHold(const string& holdId, SeatHold& seatHold) {
+        lock_guard<mutex> holdGuard(holdsMutex);
+        auto it = holds.find(holdId);
+        if (it == holds.end() || it->second.deadline <= holdTick()) return false;
+        seatHold = move(it->second);
+        holds.erase(it);
+        return true;
+    }
+    
+public:
+    
+    // ---- Headless API ----
+    // Everything below returns copies or result structs and never touches
+    // cin/cout, so it can be driven by tests, benchmarks or another front end.
+    
+    Passenger* authenticatePassenger(const string& userId, const string& password) {
+        ARS_TIME_SCOPE(Timer::Login);
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        Passenger* p = findPassenger(userId);
+        return p && p->getPassword() == password ? p : nullptr;
+    }
+    
+    Admin* authenticateAdmin(const string& userId, const string& password) {
+        ARS_TIME_SCOPE(Timer::Login);
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        Admin* a = findAdmin(userId);
+        return a && a->getPassword() == password ? a : nullptr;
+    }
+    
+    OperationResult registerPassenger(const string& name, const string& email, const string& phone,
+                                      const string& passport, const string& password) {
+        OperationResult result = {false, "", ""};
+        uint64_t seq = 0;
+        if (!isValidEmail(email)) result.error = "Invalid email format!";
+        else if (!isValidPhone(phone)) result.error = "Invalid phone number!";
+        else if (password.length() < 4) result.error = "Password too short!";
+        if (!result.error.empty()) return result;
+        {
+            shared_lock<shared_mutex> catalog(catalogMutex);
+            lock_guard<mutex> records(recordsMutex);
+            for (const auto& p : passengers) {
+                if (p.getEmail() == email) {
+                    result.error = "Email already registered!";
+                    return result;
+                }
+            }
+            TextArena::Use use(textArena);
+            Passenger newPassenger(generateId("P"), password, name, email, phone, passport);
+            insertPassenger(newPassenger);
+            journalWrite("P|" + newPassenger.toFileString(), seq);
+            result.id = newPassenger.getUserId();
+            result.success = true;
+        }
+        return settle(result, seq);
+    }
+    
+    // Adds a passenger registered on another system (a sibling shard) under
+    // the same ID; false if that ID is already here.
+    bool importPassenger(const Passenger& passenger) {
+        uint64_t seq = 0;
+        {
+            shared_lock<shared_mutex> catalog(catalogMutex);
+            lock_guard<mutex> records(recordsMutex);
+            if (findPassenger(passenger.getUserId())) return false;
+            TextArena::Use use(textArena);
+            Passenger own = passenger;
+            own.adoptText();
+            insertPassenger(own);
+            journalWrite("P|" + own.toFileString(), seq);
+        }
+        return syncJournal(seq);
+    }
+    
+    OperationResult registerAdmin(const string& name, const string& email,
+                                  const string& password, const string& level) {
+        OperationResult result = {false, "", ""};
+        uint64_t seq = 0;
+        if (!isValidEmail(email)) result.error = "Invalid email format!";
+        else if (password.length() < 4) result.error = "Password too short!";
+        if (!result.error.empty()) return result;
+        {
+            shared_lock<shared_mutex> catalog(catalogMutex);
+            lock_guard<mutex> records(recordsMutex);
+            for (const auto& a : admins) {
+                if (a.getEmail() == email) {
+                    result.error = "Email already registered!";
+                    return result;
+                }
+            }
+            TextArena::Use use(textArena);
+            Admin newAdmin(generateId("ADM"), password, name, email, toUpper(level));
+            insertAdmin(newAdmin);
+            journalWrite("A|" + newAdmin.toFileString(), seq);
+            result.id = newAdmin.getUserId();
+            result.success = true;
+        }
+        return settle(result, seq);
+    }
+    
+    OperationResult addFlight(const Flight& flight) {
+        OperationResult result = {false, "", flight.getFlightNumber()};
+        uint64_t seq = 0;
+        {
+            unique_lock<shared_mutex> catalog(catalogMutex);
+            if (findFlight(flight.getFlightNumber())) {
+                result.error = "Flight number already exists!";
+                return result;
+            }
+            publishFlightAdded(*insertFlight(flight));
+            journalWrite("F|" + flight.toFileString(), seq);
+            result.success = true;
+        }
+        return settle(result, seq);
+    }
+    
+    OperationResult removeFlight(const string& flightNumber) {
+        OperationResult result = {false, "", flightNumber};
+        uint64_t seq = 0;
+        {
+            unique_lock<shared_mutex> catalog(catalogMutex);
+            Flight* f = findFlight(flightNumber);
+            if (!f) {
+                result.error = "Flight not found!";
+                return result;
+            }
+            // A flight has confirmed bookings exactly when some of its seats are booked.
+            if (f->getBookedSeatsCount() > 0) {
+                result.error = "Cannot remove flight with active bookings!";
+                return result;
+            }
+            if (f->getHeldSeatsCount() > 0) {
+                result.error = "Cannot remove flight with seats on hold!";
+                return result;
+            }
+            eraseFlight(flightNumber);
+            publishFlightsErased();
+            journalWrite("R|" + flightNumber, seq);
+            result.success = true;
+        }
+        return settle(result, seq);
+    }
+    
+    // Searches, listings and flight lookups read the published catalog and
+    // flight copies without taking the catalog or flight locks, so they never
+    // wait on bookings or on each other. Flights with free seats come first, each group in
+    // departure-time order.
+    vector<Flight> searchFlights(const FlightQuery& query) {
+        ARS_TIME_SCOPE(Timer::Search);
+        EpochGuard epoch;
+        const FlightCatalog* current = flightCatalog.load(memory_order_acquire);
+        vector<Flight> result;
+        RouteKey key;
+        if (!FlightCatalog::findRoute(query.origin, query.destination, query.date, key)) return result;
+        auto route = current->byRoute.find(key);
+        if (route == current->byRoute.end()) return result;
+        vector<const Flight*> soldOut;
+        for (const FlightSlot* slot : *route->second) {
+            const Flight* f = slot->view.load(memory_order_acquire);
+            if (f->getAvailableSeatsCount() > 0) result.push_back(*f);
+            else if (!query.onlyAvailable) soldOut.push_back(f);
+        }
+        for (const Flight* f : soldOut) result.push_back(*f);
+        return result;
+    }
+    
+    // Direct and connecting itineraries with a free seat on every leg, best
+    // first by query.sortBy. The flight graph is still walked under the shared
+    // catalog lock; seat counts come from the published copies.
+    vector<Itinerary> searchConnections(const ConnectionQuery& query) {
+        ARS_TIME_SCOPE(Timer::SearchConnections);
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        EpochGuard epoch;
+        vector<FlightGraph::Path> paths = flightGraph.search(
+            query.origin, query.destination, query.date, query.maxLegs,
+            query.minConnectionMinutes, query.maxLayoverMinutes, query.topK, query.sortBy,
+            [this](const Flight* f) { return viewOf(f)->getAvailableSeatsCount() > 0; });
+        
+        vector<Itinerary> result;
+        for (const auto& path : paths) {
+            Itinerary itinerary = {{}, path.departure, path.arrival, 0.0};
+            for (const Flight* f : path.flights) {
+                itinerary.legs.push_back(*viewOf(f));
+                itinerary.totalFare += f->getBaseFare();
+            }
+            result.push_back(itinerary);
+        }
+        return result;
+    }
+    
+    vector<Flight> listFlights() {
+        EpochGuard epoch;
+        const FlightCatalog* current = flightCatalog.load(memory_order_acquire);
+        vector<Flight> result;
+        result.reserve(current->all.size());
+        for (const FlightSlot* slot : current->all) result.push_back(*slot->view.load(memory_order_acquire));
+        return result;
+    }
+    
+    bool getFlight(const string& flightNumber, Flight& out) {
+        EpochGuard epoch;
+        const FlightCatalog* current = flightCatalog.load(memory_order_acquire);
+        auto it = current->byNumber.find(SymbolTable::instance().lookup(flightNumber));
+        if (it == current->byNumber.end()) return false;
+        out = *it->second->view.load(memory_order_acquire);
+        return true;
+    }
+    
+    // A passenger's confirmed bookings by booking date.
+    vector<Booking> bookingsForPassenger(const string& passengerId) {
+        return bookingsForPassenger(passengerId, "", 0, numeric_limits<size_t>::max()).bookings;
+    }
+    
+    // One page of them, starting at the first booking made on or after
+    // fromDate (D/M/YYYY, or empty for the earliest).
+    BookingPage bookingsForPassenger(const string& passengerId, const string& fromDate,
+                                     size_t offset, size_t limit) {
+        BookingPage result;
+        result.total = 0;
+        int fromDay = fromDate.empty() ? numeric_limits<int32_t>::min() : parseDayNumber(fromDate);
+        if (fromDay == -1 && !fromDate.empty()) return result;
+        uint32_t passenger = SymbolTable::instance().lookup(passengerId);
+        if (passenger == SymbolTable::NONE) return result;
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        lock_guard<mutex> records(recordsMutex);
+        for (auto handle : passengerBookings.page(passenger, fromDay, offset, limit, result.total)) {
+            result.bookings.push_back(bookings[handle]);
+        }
+        return result;
+    }
+    
+    size_t bookingCount(const string& passengerId) {
+        uint32_t passenger = SymbolTable::instance().lookup(passengerId);
+        if (passenger == SymbolTable::NONE) return 0;
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        lock_guard<mutex> records(recordsMutex);
+        return passengerBookings.count(passenger);
+    }
+    
+    vector<Booking> listBookings() {
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        lock_guard<mutex> records(recordsMutex);
+        return vector<Booking>(bookings.begin(), bookings.end());
+    }
+    
+    vector<Passenger> listPassengers() {
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        lock_guard<mutex> records(recordsMutex);
+        return vector<Passenger>(passengers.begin(), passengers.end());
+    }
+    
+    vector<FlightOccupancy> flightOccupancy() {
+        EpochGuard epoch;
+        const FlightCatalog* current = flightCatalog.load(memory_order_acquire);
+        vector<FlightOccupancy> result;
+        result.reserve(current->all.size());
+        for (const FlightSlot* slot : current->all) {
+            const Flight& f = *slot->view.load(memory_order_acquire);
+            int booked = f.getBookedSeatsCount();
+            double occupancy = f.getTotalSeats() > 0 ? (booked * 100.0) / f.getTotalSeats() : 0.0;
+            result.push_back(FlightOccupancy{f.getFlightNumber(), f.getOrigin(), f.getDestination(),
+                                             f.getTotalSeats(), booked, f.getHeldSeatsCount(), occupancy});
+        }
+        return result;
+    }
+    
+    // Reads the running aggregates; no booking is visited. Routes are ranked
+    // by confirmed bookings, at most topRoutes of them.
+    SystemReport generateReport(size_t topRoutes = 5) {
+        SystemReport report;
+        aggregates.fill(report, topRoutes);
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        lock_guard<mutex> records(recordsMutex);
+        report.totalPassengers = passengers.size();
+        return report;
+    }
+    
+    // Revenue from confirmed bookings, read from the columnar mirror, which
+    // is built on the first call.
+    const BookingColumns& analytics() {
+        if (!bookingColumns.isBuilt()) {
+            shared_lock<shared_mutex> catalog(catalogMutex);
+            lock_guard<mutex> records(recordsMutex);
+            bookingColumns.build(flights, bookings);
+        }
+        return bookingColumns;
+    }
+    
+    // Times the report totals and the revenue-by-route settlement as the
+    // original string-comparing loops over the bookings, then as each
+    // available kernel over the columnar mirror.
+    void benchmarkReports(int iterations) {
+        typedef chrono::steady_clock Clock;
+        const BookingColumns& columns = analytics();
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        
+        double checksum = 0.0;
+        auto timeIt = [&](const char* name, function<double()> work) {
+            Clock::time_point start = Clock::now();
+            for (int i = 0; i < iterations; i++) checksum += work();
+            double ms = chrono::duration<double, milli>(Clock::now() - start).count() / iterations;
+            cout << "  " << left << setw(28) << name << right << setw(10) << ms << " ms" << endl;
+        };
+        
+        cout << "Report kernel benchmark: " << columns.rows() << " bookings, " << iterations
+             << " runs, cpu dispatch = " << simdLevelName(activeSimdLevel()) << endl;
+        cout << fixed << setprecision(3);
+        
+        cout << "Status totals" << endl;
+        timeIt("strings (original loop)", [&]() {
+            int confirmed = 0, cancelled = 0;
+            double revenue = 0.0;
+            for (const auto& b : bookings) {
+                if (b.isConfirmed()) {
+                    confirmed++;
+                    revenue += b.getTotalFare();
+                } else {
+                    cancelled++;
+                }
+            }
+            return revenue + confirmed + cancelled;
+        });
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+            if (level > activeSimdLevel()) continue;
+            timeIt(simdLevelName(level), [&]() {
+                StatusTotals totals = columns.statusTotals(level);
+                return totals.revenue + totals.confirmed + totals.cancelled;
+            });
+        }
+        
+        cout << "Revenue by route" << endl;
+        timeIt("strings (map per route)", [&]() {
+            unordered_map<string, string> routeOf;
+            for (const auto& f : flights) routeOf[f.getFlightNumber()] = f.getOrigin() + " -> " + f.getDestination();
+            map<string, double> revenue;
+            for (const auto& b : bookings) {
+                if (!b.isConfirmed()) continue;
+                auto route = routeOf.find(b.getFlightNumber());
+                revenue[route != routeOf.end() ? route->second : "(unknown)"] += b.getTotalFare();
+            }
+            return (double)revenue.size();
+        });
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2}) {
+            if (level > activeSimdLevel()) continue;
+            timeIt(simdLevelName(level), [&]() { return (double)columns.revenueByRoute(level).size(); });
+        }
+        if (checksum == 0.0) cout << "(no data)" << endl;
+    }
+    
+    // Dumps the metrics in Prometheus text format; an empty path writes to stdout.
+    bool exportMetrics(const string& path) const {
+        if (path.empty()) {
+            writePrometheusMetrics(cout);
+            return true;
+        }
+        ofstream file(path);
+        if (!file) return false;
+        writePrometheusMetrics(file);
+        return (bool)file;
+    }
+    
+    void printRevenueAnalytics() {
+        const BookingColumns& columns = analytics();
+        cout << fixed << setprecision(2);
+        cout << "Revenue analytics over " << columns.rows() << " bookings" << endl;
+        cout << "\n--- BY AIRLINE ---" << endl;
+        for (const auto& row : columns.revenueByAirline()) cout << row.first << ": ₹" << row.second << endl;
+        cout << "\n--- BY ROUTE ---" << endl;
+        for (const auto& row : columns.revenueByRoute()) cout << row.first << ": ₹" << row.second << endl;
+        cout << "\n--- BY BOOKING DAY ---" << endl;
+        for (const auto& row : columns.revenueByDay()) cout << formatDayNumber(row.first) << ": ₹" << row.second << endl;
+    }
+    
+    // Replay must be idempotent: a crash between writing the snapshot files
+    // and resetting the journal leaves records that are already applied.
+    void replayJournal() {
+        journal.replay([this](char type, const string& payload) {
+            applyJournalRecord(type, payload);
+        });
+    }
+    
+    void applyJournalRecord(char type, const string& payload) {
+        switch (type) {
+            case 'B': {
+                Booking b = Booking::fromFileString(payload);
+                if (b.getBookingId().empty() || findBooking(b.getBookingId())) break;
+                Flight* f = findFlight(b.getFlightNumber());
+                if (f) f->bookSeat(b.getSeatNumber());
+                RecordArena<Booking>::Handle handle = insertBooking(b);
+                if (findPassenger(b.getPassengerId())) {
+                    passengerBookings.add(b.getPassengerSymbol(), b.getBookingDay(), handle);
+                }
+                break;
+            }
+            case 'C': {
+                RecordArena<Booking>::Handle handle;
+                if (!findBookingHandle(payload, handle)) break;
+                Booking* b = &bookings[handle];
+                if (!b->isConfirmed()) break;
+                Flight* f = findFlight(b->getFlightNumber());
+                if (f) f->cancelSeat(b->getSeatNumber());
+                passengerBookings.remove(b->getPassengerSymbol(), b->getBookingDay(), handle);
+                b->setStatus("CANCELLED");
+                break;
+            }
+            case 'F': {
+                Flight f = Flight::fromFileString(payload);
+                if (!f.getFlightNumber().empty() && !findFlight(f.getFlightNumber())) {
+                    insertFlight(f);
+                }
+                break;
+            }
+            case 'R': {
+                Flight* f = findFlight(payload);
+                if (f && f->getAvailableSeatsCount() == f->getTotalSeats()) {
+                    eraseFlight(payload);
+                }
+                break;
+            }
+            case 'P': {
+                Passenger p = Passenger::fromFileString(payload);
+                if (!p.getUserId().empty() && !findPassenger(p.getUserId())) {
+                    insertPassenger(p);
+                }
+                break;
+            }
+            case 'A': {
+                Admin a = Admin::fromFileString(payload);
+                if (!a.getUserId().empty() && !findAdmin(a.getUserId())) {
+                    insertAdmin(a);
+                }
+                break;
+            }
+        }
+    }
+    
+    void clearData() {
+        waitForCheckpoint();
+        currentPassenger = nullptr;
+        currentAdmin = nullptr;
+        passengerIndex.clear();
+        adminIndex.clear();
+        flightIndex.clear();
+        bookingIndex.clear();
+        passengerBookings.clear();
+        flightGraph.clear();
+        bookingColumns.clear();
+        passengers.clear();
+        admins.clear();
+        flights.clear();
+        bookings.clear();
+        textArena.clear();
+        publishCatalog();
+    }
+    
+    // The original sequential loader: getline through an ifstream and a
+    // vector<string> of substr copies per line. Kept as the benchmark baseline.
+    template <typename Record, typename Insert>
+    static void loadStreamed(const string& path, Insert insert) {
+        ifstream file(path);
+        string line;
+        vector<string> fields;
+        string_view tokens[Record::FIELD_COUNT];
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+            fields.clear();
+            size_t pos = 0, prev = 0;
+            while ((pos = line.find('|', prev)) != string::npos) {
+                fields.push_back(line.substr(prev, pos - prev));
+                prev = pos + 1;
+            }
+            fields.push_back(line.substr(prev));
+            size_t count = min(fields.size(), Record::FIELD_COUNT);
+            for (size_t i = 0; i < count; i++) tokens[i] = fields[i];
+            insert(Record::fromTokens(tokens, count));
+        }
+    }
+    
+    void loadAllDataStreamed() {
+        TextArena::Use use(textArena);
+        loadStreamed<Passenger>(PASSENGERS_FILE, [this](Passenger p) { insertPassenger(move(p)); });
+        loadStreamed<Admin>(ADMINS_FILE, [this](Admin a) { insertAdmin(move(a)); });
+        loadStreamed<Flight>(FLIGHTS_FILE, [this](Flight f) { insertFlight(move(f)); });
+        loadStreamed<Booking>(BOOKINGS_FILE, [this](Booking b) { insertBooking(move(b)); });
+        replayJournal();
+        publishCatalog();
+        aggregates.rebuild(flights, bookings);
+    }
+    
+    void benchmarkStartup(int iterations) {
+        typedef chrono::steady_clock Clock;
+        double streamedMs = 0.0, mappedMs = 0.0;
+        
+        for (int i = 0; i < iterations; i++) {
+            clearData();
+            Clock::time_point start = Clock::now();
+            loadAllDataStreamed();
+            streamedMs += chrono::duration<double, milli>(Clock::now() - start).count();
+            
+            clearData();
+            start = Clock::now();
+            loadAllData();
+            mappedMs += chrono::duration<double, milli>(Clock::now() - start).count();
+        }
+        
+        cout << "Startup load benchmark (" << iterations << " runs)" << endl;
+        cout << "Records: " << passengers.size() << " passengers, " << admins.size() << " admins, "
+             << flights.size() << " flights, " << bookings.size() << " bookings" << endl;
+        cout << fixed << setprecision(2);
+        cout << "getline + token copies: " << streamedMs / iterations << " ms/load" << endl;
+        cout << "parallel loader:        " << mappedMs / iterations << " ms/load"
+             << " (" << workerThreads() << " threads, "
+             << (snapshotFormat == SnapshotFormat::Binary ? "snapshot.bin" : "text files") << ")" << endl;
+        if (mappedMs > 0) cout << "Speedup: " << streamedMs / mappedMs << "x" << endl;
+    }
+    
+    bool savePassengers(const SnapshotImage& image, const ImageBookings& imageBookings) {
+        unordered_map<uint32_t, string> lists;
+        for (const Booking& b : imageBookings) {
+            if (!b.isConfirmed()) continue;
+            string& list = lists[b.getPassengerSymbol()];
+            if (!list.empty()) list += ',';
+            list += b.getBookingId();
+        }
+        SymbolTable& symbols = SymbolTable::instance();
+        const string empty;
+        return replaceFile(PASSENGERS_FILE, [&](ofstream& file) {
+            for (const auto& p : passengers.prefix(image.passengerCount)) {
+                auto list = lists.find(symbols.lookup(p.getUserId()));
+                file << p.toFileString(list != lists.end() ? list->second : empty) << '\n';
+            }
+            ARS_COUNT(Counter::SnapshotBytesWritten, file.tellp());
+        });
+    }
+    
+    bool saveAdmins(const SnapshotImage& image) {
+        return replaceFile(ADMINS_FILE, [&](ofstream& file) {
+            for (const auto& a : image.admins) {
+                file << a.toFileString() << '\n';
+            }
+            ARS_COUNT(Counter::SnapshotBytesWritten, file.tellp());
+        });
+    }
+    
+    bool saveFlights(const SnapshotImage& image) {
+        return replaceFile(FLIGHTS_FILE, [&](ofstream& file) {
+            for (const auto& f : image.flights) {
+                file << f.toFileString() << '\n';
+            }
+            ARS_COUNT(Counter::SnapshotBytesWritten, file.tellp());
+        });
+    }
+    
+    bool saveBookings(const ImageBookings& imageBookings) {
+        return replaceFile(BOOKINGS_FILE, [&](ofstream& file) {
+            for (const Booking& b : imageBookings) {
+                file << b.toFileString() << '\n';
+            }
+            ARS_COUNT(Counter::SnapshotBytesWritten, file.tellp());
+        });
+    }
+    
+
+    void registerPassenger() {
+        clearScreen();
+        cout << "\n=====================================" << endl;
+        cout << "     PASSENGER REGISTRATION         " << endl;
+        cout << "=====================================" << endl;
+        
+        string name, email, phone, passport, password;
+        
+        cin.ignore();
+        cout << "\nEnter Full Name: ";
+        getline(cin, name);
+        
+        cout << "Enter Email: ";
+        getline(cin, email);
+        while (!isValidEmail(email)) {
+            cout << "Invalid email format! Enter again: ";
+            getline(cin, email);
+        }
+        
+        cout << "Enter Phone: ";
+        getline(cin, phone);
+        while (!isValidPhone(phone)) {
+            cout << "Invalid phone number! Enter 10 digits: ";
+            getline(cin, phone);
+        }
+        
+        cout << "Enter Passport Number: ";
+        getline(cin, passport);
+        
+        cout << "Enter Password: ";
+        getline(cin, password);
+        while (password.length() < 4) {
+            cout << "Password too short! Minimum 4 characters: ";
+            getline(cin, password);
+        }
+        
+        OperationResult result = registerPassenger(name, email, phone, passport, password);
+        if (!result.success) {
+            cout << "\nERROR: " << result.error << endl;
+            pauseScreen();
+            return;
+        }
+        
+        cout << "\nSUCCESS: Registration Successful!" << endl;
+        cout << "Your User ID: " << result.id << endl;
+        cout << "Please remember your credentials." << endl;
+        pauseScreen();
+    }
+    
+    void registerAdmin() {
+        clearScreen();
+        cout << "\n=====================================" << endl;
+        cout << "        ADMIN REGISTRATION          " << endl;
+        cout << "=====================================" << endl;
+        
+        string name, email, password, level;
+        
+        cin.ignore();
+        cout << "\nEnter Full Name: ";
+        getline(cin, name);
+        
+        cout << "Enter Email: ";
+        getline(cin, email);
+        while (!isValidEmail(email)) {
+            cout << "Invalid email format! Enter again: ";
+            getline(cin, email);
+        }
+        
+        cout << "Enter Password: ";
+        getline(cin, password);
+        while (password.length() < 4) {
+            cout << "Password too short! Minimum 4 characters: ";
+            getline(cin, password);
+        }
+        
+        cout << "Enter Admin Level (SUPER/REGULAR): ";
+        getline(cin, level);
+        
+        OperationResult result = registerAdmin(name, email, password, level);
+        if (!result.success) {
+            cout << "\nERROR: " << result.error << endl;
+            pauseScreen();
+            return;
+        }
+        
+        cout << "\nSUCCESS: Admin Registration Successful!" << endl;
+        cout << "Admin ID: " << result.id << endl;
+        pauseScreen();
+    }
+    
+    bool loginPassenger() {
+        clearScreen();
+        cout << "\n======================================" << endl;
+        cout << "        PASSENGER LOGIN             " << endl;
+        cout << "=======================================" << endl;
+        
+        string userId, password;
+        cin.ignore();
+        cout << "\nUser ID: ";
+        getline(cin, userId);
+        cout << "Password: ";
+        getline(cin, password);
+        
+        Passenger* p = authenticatePassenger(userId, password);
+        if (p) {
+            currentPassenger = p;
+            cout << "\nSUCCESS: Login Successful! Welcome, " << p->getName() << endl;
+            pauseScreen();
+            return true;
+        }
+        
+        cout << "\nERROR: Invalid credentials!" << endl;
+        pauseScreen();
+        return false;
+    }
+    
+    bool loginAdmin() {
+        clearScreen();
+        cout << "\n======================================" << endl;
+        cout << "          ADMIN LOGIN               " << endl;
+        cout << "=======================================" << endl;
+        
+        string userId, password;
+        cin.ignore();
+        cout << "\nUser ID: ";
+        getline(cin, userId);
+        cout << "Password: ";
+        getline(cin, password);
+        
+        Admin* a = authenticateAdmin(userId, password);
+        if (a) {
+            currentAdmin = a;
+            cout << "\nSUCCESS: Admin Login Successful! Welcome, " << a->getName() << endl;
+            pauseScreen();
+            return true;
+        }
+        
+        cout << "\nERROR: Invalid admin credentials!" << endl;
+        pauseScreen();
+        return false;
+    }
+    
+ 
+    void searchFlights() {
+        clearScreen();
+        cout << "\n======================================" << endl;
+        cout << "        SEARCH FLIGHTS              " << endl;
+        cout << "=======================================" << endl;
+        
+        string origin, destination, date;
+        cin.ignore();
+        cout << "\nOrigin City: ";
+        getline(cin, origin);
+        cout << "Destination City: ";
+        getline(cin, destination);
+        cout << "Date (DD/MM/YYYY): ";
+        getline(cin, date);
+        
+        FlightQuery query;
+        query.origin = origin;
+        query.destination = destination;
+        query.date = date;
+        vector<Flight> results = searchFlights(query);
+        
+        cout << "\n*** SEARCH RESULTS ***\n";
+        for (const auto& f : results) {
+            f.displayFlightInfo();
+        }
+        
+        ConnectionQuery connectionQuery;
+        connectionQuery.origin = origin;
+        connectionQuery.destination = destination;
+        connectionQuery.date = date;
+        int connections = 0;
+        for (const auto& itinerary : searchConnections(connectionQuery)) {
+            if (itinerary.legs.size() < 2) continue;
+            if (connections++ == 0) cout << "\n*** CONNECTING FLIGHTS ***\n";
+            cout << "\n" << connections << ". ";
+            for (size_t i = 0; i < itinerary.legs.size(); i++) {
+                const Flight& leg = itinerary.legs[i];
+                if (i > 0) cout << "   ";
+                cout << leg.getFlightNumber() << "  " << leg.getOrigin() << " " << leg.getDepartureTime()
+                     << " -> " << leg.getDestination() << " " << leg.getArrivalTime() << endl;
+            }
+            cout << "   Arrives: " << formatDayNumber(itinerary.arrival / 1440) << " "
+                 << formatMinutes(itinerary.arrival % 1440)
+                 << " | Total Fare: ₹" << fixed << setprecision(2) << itinerary.totalFare << endl;
+        }
+        
+        if (results.empty() && connections == 0) {
+            cout << "\nNo flights found matching your criteria." << endl;
+        }
+        
+        pauseScreen();
+    }
+    
+    void viewAllFlights() {
+        clearScreen();
+        cout << "\n======================================" << endl;
+        cout << "       AVAILABLE FLIGHTS            " << endl;
+        cout << "===================================== " << endl;
+        
+        vector<Flight> all = listFlights();
+        if (all.empty()) {
+            cout << "\nNo flights available." << endl;
+            pauseScreen();
+            return;
+        }
+        
+        int index = 1;
+        for (const auto& f : all) {
+            cout << "\n" << index++ << ". ";
+            f.displayFlightInfo();
+        }
+        
+        pauseScreen();
+    }
+    
+    void bookFlight() {
+        if (!currentPassenger) return;
+        
+        clearScreen();
+        viewAllFlights();
+        
+        cout << "\nEnter Flight Number to book: ";
+        string flightNum;
+        cin >> flightNum;
+        
+        Flight selectedFlight;
+        if (!getFlight(flightNum, selectedFlight)) {
+            cout << "\nERROR: Flight not found!" << endl;
+            pauseScreen();
+            return;
+        }
+        
+        if (selectedFlight.getAvailableSeatsCount() <= 0) {
+            cout << "\nERROR: No seats available!" << endl;
+            pauseScreen();
+            return;
+        }
+        
+        selectedFlight.displaySeatMap();
+        
+        cout << "\nAuto-assign: 1. Window  2. Aisle  3. Next to my booking  4. Any (front rows first)" << endl;
+        string seatNum;
+        cout << "\nEnter Seat Number (e.g., A1) or 1-4 to auto-assign: ";
+        cin >> seatNum;
+        
+        // The seat is held while the passenger reviews the fare, so nobody
+        // else can take it between choosing and confirming.
+        HoldResult held;
+        if (seatNum.size() == 1 && seatNum[0] >= '1' && seatNum[0] <= '4') {
+            SeatPreference preference;
+            if (seatNum == "1") preference.position = SeatPosition::Window;
+            if (seatNum == "2") preference.position = SeatPosition::Aisle;
+            if (seatNum == "3") {
+                for (const auto& b : bookingsForPassenger(currentPassenger->getUserId())) {
+                    if (b.getFlightNumber() == flightNum && b.isConfirmed()) {
+                        preference.nextTo = b.getSeatNumber();
+                    }
+                }
+            }
+            held = hold(flightNum, preference);
+        } else {
+            held = hold(flightNum, seatNum);
+        }
+        if (!held.success) {
+            cout << "\nERROR: " << held.error << endl;
+            pauseScreen();
+            return;
+        }
+        cout << "\nSeat " << held.seat << " is held for you for "
+             << DEFAULT_HOLD_TTL_SECONDS / 60 << " minutes." << endl;
+        cout << "Fare: ₹" << fixed << setprecision(2) << selectedFlight.getBaseFare() << endl;
+        cout << "Confirm booking? (y/n): ";
+        char confirm;
+        cin >> confirm;
+        if (tolower(confirm) != 'y') {
+            releaseHold(held.holdId);
+            cout << "\nBooking not confirmed. Seat released." << endl;
+            pauseScreen();
+            return;
+        }
+        
+        BookingResult result = confirmHold(held.holdId, currentPassenger->getUserId());
+        
+        if (result.success) {
+            cout << "\n*** BOOKING SUCCESSFUL! ***" << endl;
+            result.booking.displayBookingInfo();
+        } else {
+            cout << "\nERROR: " << result.error << endl;
+        }
+        
+        pauseScreen();
+    }
+    
+    static constexpr size_t BOOKINGS_PER_PAGE = 10;
+    
+    // Longer lists are shown a page at a time; the prompt replaces the pause.
+    void viewMyBookings() {
+        if (!currentPassenger) return;
+        
+        string fromDate;
+        size_t offset = 0;
+        bool paging = false;
+        while (true) {
+            BookingPage page = bookingsForPassenger(currentPassenger->getUserId(), fromDate,
+                                                    offset, BOOKINGS_PER_PAGE);
+            clearScreen();
+            cout << "\n======================================" << endl;
+            cout << "        MY BOOKINGS                 " << endl;
+            cout << "======================================" << endl;
+            
+            if (page.bookings.empty()) {
+                cout << "\nNo bookings found." << endl;
+            }
+            
+            for (const auto& b : page.bookings) {
+                b.displayBookingInfo();
+            }
+            
+            if (!paging && page.total <= BOOKINGS_PER_PAGE) {
+                pauseScreen();
+                return;
+            }
+            if (!paging) {
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                paging = true;
+            }
+            
+            if (!page.bookings.empty()) {
+                cout << "\nShowing " << offset + 1 << "-" << offset + page.bookings.size()
+                     << " of " << page.total;
+                if (!fromDate.empty()) cout << " booked on or after " << fromDate;
+                cout << endl;
+            }
+            cout << "n = next page, p = previous page, d = from date, Enter = back: ";
+            string choice;
+            if (!getline(cin, choice) || choice.empty()) return;
+            if (choice == "n" && offset + BOOKINGS_PER_PAGE < page.total) {
+                offset += BOOKINGS_PER_PAGE;
+            } else if (choice == "p" && offset >= BOOKINGS_PER_PAGE) {
+                offset -= BOOKINGS_PER_PAGE;
+            } else if (choice == "d") {
+                cout << "From date (D/M/YYYY, empty for all): ";
+                getline(cin, fromDate);
+                if (!fromDate.empty() && parseDayNumber(fromDate) < 0) fromDate.clear();
+                offset = 0;
+            }
+        }
+    }
+    
+    void cancelBooking() {
+        if (!currentPassenger) return;
+        
+        clearScreen();
+        viewMyBookings();
+        
+        string bookingId;
+        cout << "\nEnter Booking ID to cancel: ";
+        cin >> bookingId;
+        
+        BookingResult result = cancel(bookingId, currentPassenger->getUserId());
+        if (result.success) {
+            cout << "\nSUCCESS: Booking Cancelled Successfully!" << endl;
+            cout << "Refund of ₹" << fixed << setprecision(2) 
+                 << result.booking.getTotalFare() << " will be processed." << endl;
+            pauseScreen();
+            return;
+        }
+        
+        cout << "\nERROR: " << result.error << endl;
+        pauseScreen();
+    }
+    
+ 
+    void addFlight() {
+        clearScreen();
+        cout << "\n=====================================" << endl;
+        cout << "          ADD NEW FLIGHT            " << endl;
+        cout << "=====================================" << endl;
+        
+        string flightNum, airline, origin, dest, date, depTime, arrTime;
+        int seats;
+        double fare;
+        
+        cin.ignore();
+        cout << "\nFlight Number: ";
+        getline(cin, flightNum);
+        cout << "Airline Name: ";
+        getline(cin, airline);
+        cout << "Origin: ";
+        getline(cin, origin);
+        cout << "Destination: ";
+        getline(cin, dest);
+        cout << "Date (DD/MM/YYYY): ";
+        getline(cin, date);
+        cout << "Departure Time (HH:MM): ";
+        getline(cin, depTime);
+        cout << "Arrival Time (HH:MM): ";
+        getline(cin, arrTime);
+        cout << "Total Seats: ";
+        cin >> seats;
+        cout << "Base Fare (₹): ";
+        cin >> fare;
+        
+        OperationResult result = addFlight(Flight(flightNum, airline, origin, dest, date,
+                                                  depTime, arrTime, seats, fare));
+        if (!result.success) {
+            cout << "\nERROR: " << result.error << endl;
+            pauseScreen();
+            return;
+        }
+        
+        cout << "\nSUCCESS: Flight Added Successfully!" << endl;
+        pauseScreen();
+    }
+    
+    void removeFlight() {
+        clearScreen();
+        viewAllFlights();
+        
+        string flightNum;
+        cout << "\nEnter Flight Number to remove: ";
+        cin >> flightNum;
+        
+        OperationResult result = removeFlight(flightNum);
+        if (result.success) {
+            cout << "\nSUCCESS: Flight Removed Successfully!" << endl;
+        } else {
+            cout << "\nERROR: " << result.error << endl;
+        }
+        pauseScreen();
+    }
+    
+    void viewAllBookings() {
+        clearScreen();
+        cout << "\n======================================" << endl;
+        cout << "      ALL BOOKINGS (ADMIN)          " << endl;
+        cout << "======================================" << endl;
+        
+        vector<Booking> all = listBookings();
+        if (all.empty()) {
+            cout << "\nNo bookings found." << endl;
+            pauseScreen();
+            return;
+        }
+        
+        for (const auto& b : all) {
+            b.displayBookingInfo();
+        }
+        
+        StatusTotals totals = analytics().statusTotals();
+        cout << "\n========== SUMMARY ==========" << endl;
+        cout << "Total Bookings: " << all.size() << endl;
+        cout << "Confirmed: " << totals.confirmed << endl;
+        cout << "Cancelled: " << totals.cancelled << endl;
+        cout << "Total Revenue: ₹" << fixed << setprecision(2) << totals.revenue << endl;
+        cout << "=============================" << endl;
+        
+        pauseScreen();
+    }
+    
+    void viewAllPassengers() {
+        clearScreen();
+        cout << "\n=====================================" << endl;
+        cout << "     ALL PASSENGERS (ADMIN)         " << endl;
+        cout << "======================================" << endl;
+        
+        vector<Passenger> all = listPassengers();
+        if (all.empty()) {
+            cout << "\nNo passengers registered." << endl;
+            pauseScreen();
+            return;
+        }
+        
+        for (size_t i = 0; i < all.size(); i++) {
+            cout << "\n--- Passenger " << (i + 1) << " ---" << endl;
+            all[i].displayInfo();
+            cout << "Total Bookings: " << bookingCount(all[i].getUserId()) << endl;
+        }
+        
+        cout << "\n\nTotal Passengers: " << all.size() << endl;
+        pauseScreen();
+    }
+    
+    void viewFlightOccupancy() {
+        clearScreen();
+        cout << "\n=====================================" << endl;
+        cout << "      FLIGHT OCCUPANCY REPORT       " << endl;
+        cout << "=====================================" << endl;
+
+        vector<FlightOccupancy> report = flightOccupancy();
+        if (report.empty()) {
+            cout << "\nNo flights available." << endl;
+            pauseScreen();
+            return;
+        }
+
+        for (const auto& f : report) {
+            double occupancy = f.occupancy;
+            
+            cout << "\n----------------------------------------" << endl;
+            cout << "Flight: " << f.flightNumber << endl;
+            cout << "Route: " << f.origin << " -> " << f.destination << endl;
+            cout << "Total Seats: " << f.totalSeats << endl;
+            cout << "Booked: " << f.bookedSeats << endl;
+            if (f.heldSeats > 0) cout << "On Hold: " << f.heldSeats << endl;
+            cout << "Available: " << (f.totalSeats - f.bookedSeats - f.heldSeats) << endl;
+            cout << "Occupancy: " << fixed << setprecision(2) << occupancy << "%" << endl;
+            
+            cout << "Status: [";
+            int filled = (int)(occupancy / 5);
+            for (int i = 0; i < 20; i++) {
+                if (i < filled) cout << "#";
+                else cout << "-";
+            }
+            cout << "] " << occupancy << "%" << endl;
+        }
+        
+        pauseScreen();
+    }
+    
+    void generateReports() {
+        clearScreen();
+        cout << "\n=====================================" << endl;
+        cout << "        SYSTEM REPORTS              " << endl;
+        cout << "======================================" << endl;
+        
+        SystemReport report = generateReport();
+        double avgBookingValue = report.confirmedBookings > 0 ? report.totalRevenue / report.confirmedBookings : 0.0;
+        double systemOccupancy = report.totalSeats > 0 ? (report.bookedSeats * 100.0) / report.totalSeats : 0.0;
+        
+        cout << "\n========== AIRLINE SYSTEM REPORT ==========" << endl;
+        cout << "\n--- FLEET STATISTICS ---" << endl;
+        cout << "Total Flights: " << report.totalFlights << endl;
+        cout << "Total Seat Capacity: " << report.totalSeats << endl;
+        cout << "Booked Seats: " << report.bookedSeats << endl;
+        cout << "Available Seats: " << (report.totalSeats - report.bookedSeats) << endl;
+        cout << "Overall Occupancy: " << fixed << setprecision(2) << systemOccupancy << "%" << endl;
+        
+        cout << "\n--- PASSENGER STATISTICS ---" << endl;
+        cout << "Registered Passengers: " << report.totalPassengers << endl;
+        cout << "Total Bookings: " << report.totalBookings << endl;
+        cout << "Confirmed Bookings: " << report.confirmedBookings << endl;
+        cout << "Cancelled Bookings: " << report.cancelledBookings << endl;
+        
+        cout << "\n--- FINANCIAL STATISTICS ---" << endl;
+        cout << "Total Revenue: ₹" << fixed << setprecision(2) << report.totalRevenue << endl;
+        cout << "Average Booking Value: ₹" << fixed << setprecision(2) << avgBookingValue << endl;
+        
+        if (!report.airlines.empty()) {
+            cout << "\n--- REVENUE BY AIRLINE ---" << endl;
+            for (const auto& airline : report.airlines) {
+                cout << airline.first << ": ₹" << fixed << setprecision(2) << airline.second.revenue
+                     << " (" << airline.second.confirmed << " bookings)" << endl;
+            }
+        }
+        
+        cout << "\n--- TOP ROUTES ---" << endl;
+        if (report.topRoutes.empty()) {
+            cout << "No booking data available." << endl;
+        } else {
+            int rank = 1;
+            for (const auto& route : report.topRoutes) {
+                cout << rank++ << ". " << route.first << " (" << route.second << " bookings)" << endl;
+            }
+        }
+        
+        cout << "\n===========================================" << endl;
+        cout << "Report Generated on: " << getCurrentDate() << endl;
+        cout << "===========================================" << endl;
+        
+        pauseScreen();
+    }
+    
+    void exportMetrics() {
+        clearScreen();
+        string path;
+        cout << "\nEnter file path for metrics (blank for screen): ";
+        cin.ignore();
+        getline(cin, path);
+        
+        if (!exportMetrics(path)) {
+            cout << "\nERROR: Could not write " << path << endl;
+        } else if (!path.empty()) {
+            cout << "\nSUCCESS: Metrics written to " << path << endl;
+        }
+        pauseScreen();
+    }
+    
+
+    void passengerMenu() {
+        int choice;
+        do {
+            clearScreen();
+            cout << "\n=====================================" << endl;
+            cout << "      PASSENGER DASHBOARD           " << endl;
+            cout << "=====================================" << endl;
+            cout << "\nWelcome, " << currentPassenger->getName() << "!" << endl;
+            cout << "\n1. Search Flights" << endl;
+            cout << "2. View All Flights" << endl;
+            cout << "3. Book a Flight" << endl;
+            cout << "4. View My Bookings" << endl;
+            cout << "5. Cancel Booking" << endl;
+            cout << "6. My Profile" << endl;
+            cout << "7. Logout" << endl;
+            cout << "----------------------------------" << endl;
+            cout << "Enter choice: ";
+            cin >> choice;
+            
+            switch (choice) {
+                case 1:
+                    searchFlights();
+                    break;
+                case 2:
+                    viewAllFlights();
+                    break;
+                case 3:
+                    bookFlight();
+                    break;
+                case 4:
+                    viewMyBookings();
+                    break;
+                case 5:
+                    cancelBooking();
+                    break;
+                case 6:
+                    clearScreen();
+                    cout << "\n=== MY PROFILE ===" << endl;
+                    currentPassenger->displayInfo();
+                    cout << "Total Bookings: " << bookingCount(currentPassenger->getUserId()) << endl;
+                    pauseScreen();
+                    break;
+                case 7:
+                    currentPassenger = nullptr;
+                    cout << "\nLogged out successfully!" << endl;
+                    pauseScreen();
+                    break;
+                default:
+                    cout << "\nInvalid choice!" << endl;
+                    pauseScreen();
+            }
+        } while (choice != 7);
+    }
+    
+    void adminMenu() {
+        int choice;
+        do {
+            clearScreen();
+            cout << "\n=====================================" << endl;
+            cout << "       ADMIN DASHBOARD              " << endl;
+            cout << "=====================================" << endl;
+            cout << "\nWelcome, " << currentAdmin->getName() << "!" << endl;
+            cout << "\n1. Add New Flight" << endl;
+            cout << "2. Remove Flight" << endl;
+            cout << "3. View All Flights" << endl;
+            cout << "4. View All Bookings" << endl;
+            cout << "5. View All Passengers" << endl;
+            cout << "6. Flight Occupancy Report" << endl;
+            cout << "7. Generate System Reports" << endl;
+            cout << "8. Register New Admin" << endl;
+            cout << "9. Export Metrics" << endl;
+            cout << "10. Logout" << endl;
+            cout << "-------------------------------------" << endl;
+            cout << "Enter choice: ";
+            cin >> choice;
+            
+            switch (choice) {
+                case 1:
+                    addFlight();
+                    break;
+                case 2:
+                    removeFlight();
+                    break;
+                case 3:
+                    viewAllFlights();
+                    break;
+                case 4:
+                    viewAllBookings();
+                    break;
+                case 5:
+                    viewAllPassengers();
+                    break;
+                case 6:
+                    viewFlightOccupancy();
+                    break;
+                case 7:
+                    generateReports();
+                    break;
+                case 8:
+                    if (currentAdmin->getAdminLevel() == "SUPER") {
+                        registerAdmin();
+                    } else {
+                        cout << "\nERROR: Only SUPER admins can register new admins!" << endl;
+                        pauseScreen();
+                    }
+                    break;
+                case 9:
+                    exportMetrics();
+                    break;
+                case 10:
+                    currentAdmin = nullptr;
+                    cout << "\nLogged out successfully!" << endl;
+                    pauseScreen();
+                    break;
+                default:
+                    cout << "\nInvalid choice!" << endl;
+                    pauseScreen();
+            }
+        } while (choice != 10);
+    }
+    
+    void mainMenu() {
+        int choice;
+        do {
+            clearScreen();
+            cout << "\n=====================================" << endl;
+            cout << "   AIRLINE RESERVATION SYSTEM       " << endl;
+            cout << "         (Pro Level Edition)        " << endl;
+            cout << "=====================================" << endl;
+            cout << "\n1. Passenger Login" << endl;
+            cout << "2. Passenger Registration" << endl;
+            cout << "3. Admin Login" << endl;
+            cout << "4. Exit" << endl;
+            cout << "-------------------------------------" << endl;
+            cout << "Enter choice: ";
+            cin >> choice;
+            
+            switch (choice) {
+                case 1:
+                    if (loginPassenger()) {
+                        passengerMenu();
+                    }
+                    break;
+                case 2:
+                    registerPassenger();
+                    break;
+                case 3:
+                    if (loginAdmin()) {
+                        adminMenu();
+                    }
+                    break;
+                case 4:
+                    if (!saveAllData()) cout << "\nERROR: Data could not be saved!" << endl;
+                    cout << "\nThank you for using Airline Reservation System!" << endl;
+                    cout << "Safe travels!\n" << endl;
+                    break;
+                default:
+                    cout << "\nInvalid choice! Please try again." << endl;
+                    pauseScreen();
+            }
+        } while (choice != 4);
+    }
+    
+    void run() {
+        mainMenu();
+    }
+};
+
+
+// A thread draining its own FIFO of tasks. Each shard of a
+// ShardedReservationSystem is owned by one, so every change to the shard
+// runs on that thread and the shard's locks are never contended.
+class ShardWorker {
+private:
+    mutex queueMutex;
+    condition_variable wake;
+    deque<function<void()>> tasks;
+    bool stopping;
+    thread worker;
+
+    void run() {
+        unique_lock<mutex> guard(queueMutex);
+        while (true) {
+            wake.wait(guard, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;
+            deque<function<void()>> batch;
+            batch.swap(tasks);
+            guard.unlock();
+            for (auto& task : batch) task();
+            guard.lock();
+        }
+    }
+
+public:
+    ShardWorker() : stopping(false), worker(&ShardWorker::run, this) {}
+
+    // Runs what is already queued, then stops.
+    ~ShardWorker() {
+        {
+            lock_guard<mutex> guard(queueMutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    ShardWorker(const ShardWorker&) = delete;
+    ShardWorker& operator=(const ShardWorker&) = delete;
+
+    template <typename Work>
+    auto submit(Work work) -> future<decltype(work())> {
+        auto task = make_shared<packaged_task<decltype(work())()>>(move(work));
+        auto result = task->get_future();
+        {
+            lock_guard<mutex> guard(queueMutex);
+            tasks.push_back([task]() { (*task)(); });
+        }
+        wake.notify_one();
+        return result;
+    }
+};
+
+
+// Sharded mode. Flights, with their bookings, holds and journal, are split
+// by flight-number hash across independent ReservationSystems kept in
+// dataDir/shard-<k>, each owned by one ShardWorker. Bookings, cancellations
+// and flight changes are queued to the owning shard; searches, listings and
+// reports read every shard's published data from the caller's thread and
+// are merged here. Passengers are registered on every shard so each one
+// can check its bookings locally, and booking IDs stay unique across shards
+// because they all come from the process-wide ID counter.
+//
+// Operations spanning flights (connection search, batch bookings) and seat
+// holds are not routed; use ReservationSystem for those.
+class ShardedReservationSystem {
+private:
+    struct Shard {
+        unique_ptr<ShardWorker> worker;
+        unique_ptr<ReservationSystem> system;
+    };
+
+    vector<Shard> shards;
+    // getBookingKey() -> shard, for bookings made since startup; older ones
+    // are looked for on every shard.
+    PartitionedIndex<uint32_t, int32_t, FlatIntMap<int32_t, uint32_t>> bookingShards;
+
+    // FNV-1a, so a flight stays on the same shard across builds and runs.
+    size_t shardOf(const string& flightNumber) const {
+        uint32_t hash = 2166136261u;
+        for (unsigned char c : flightNumber) hash = (hash ^ c) * 16777619u;
+        return hash % shards.size();
+    }
+
+    ReservationSystem& shard(size_t k) { return *shards[k].system; }
+
+    // Runs work on shard k's worker and returns once its journal records
+    // are on disk. The worker only queues them (see DeferredSync); the fsync
+    // is waited for here, on the calling thread, so the worker moves on to
+    // the next task and its records join the same group commit.
+    template <typename Work>
+    auto onShard(size_t k, Work work) -> decltype(work(declval<ReservationSystem&>())) {
+        typedef decltype(work(declval<ReservationSystem&>())) Result;
+        ReservationSystem& system = shard(k);
+        pair<Result, uint64_t> done = shards[k].worker->submit([&system, &work]() {
+            ReservationSystem::DeferredSync deferred(system);
+            Result result = work(system);
+            return make_pair(move(result), deferred.sequence());
+        }).get();
+        if (!system.syncJournal(done.second)) ReservationSystem::markUnsaved(done.first);
+        return move(done.first);
+    }
+
+    // Runs work on every shard's worker at once; results in shard order.
+    template <typename Work>
+    auto onAllShards(Work work) -> vector<decltype(work(declval<ReservationSystem&>()))> {
+        typedef decltype(work(declval<ReservationSystem&>())) Result;
+        vector<future<pair<Result, uint64_t>>> pending;
+        for (auto& s : shards) {
+            ReservationSystem& system = *s.system;
+            pending.push_back(s.worker->submit([&system, &work]() {
+                ReservationSystem::DeferredSync deferred(system);
+                Result result = work(system);
+                return make_pair(move(result), deferred.sequence());
+            }));
+        }
+        vector<Result> results;
+        for (size_t k = 0; k < shards.size(); k++) {
+            pair<Result, uint64_t> done = pending[k].get();
+            if (!shard(k).syncJournal(done.second)) ReservationSystem::markUnsaved(done.first);
+            results.push_back(move(done.first));
+        }
+        return results;
+    }
+
+    static void makeDirectory(const string& dir) {
+        error_code error;
+        filesystem::create_directories(dir, error);
+        if (error) throw runtime_error("cannot create " + dir + ": " + error.message());
+    }
+
+    void remember(const BookingResult& result, size_t k) {
+        if (result.success) bookingShards.set(result.booking.getBookingKey(), (uint32_t)k);
+    }
+
+public:
+    // The shard count is recorded in dataDir/shards.txt on first use; the
+    // same directory must always be opened with that count, since it decides
+    // where each flight lives.
+    ShardedReservationSystem(const string& dataDir, size_t shardCount) {
+        if (shardCount == 0) throw runtime_error("at least one shard is required");
+        makeDirectory(dataDir);
+        string countFile = dataDir + "/shards.txt";
+        size_t recorded = 0;
+        ifstream existing(countFile);
+        if (existing >> recorded && recorded != shardCount) {
+            throw runtime_error(dataDir + " holds " + to_string(recorded) + " shards, not " +
+                                to_string(shardCount));
+        }
+        if (!recorded && !replaceFile(countFile, [&](ofstream& file) { file << shardCount << "\n"; })) {
+            throw runtime_error("cannot write " + countFile);
+        }
+        
+        shards.resize(shardCount);
+        vector<future<void>> loading;
+        for (size_t k = 0; k < shardCount; k++) {
+            string shardDir = dataDir + "/shard-" + to_string(k);
+            makeDirectory(shardDir);
+            shards[k].worker.reset(new ShardWorker());
+            Shard& s = shards[k];
+            loading.push_back(s.worker->submit([&s, shardDir]() {
+                s.system.reset(new ReservationSystem(shardDir, false));
+            }));
+        }
+        for (auto& f : loading) f.get();
+    }
+
+    // Each shard saves and shuts down on its own worker, all at once.
+    ~ShardedReservationSystem() {
+        vector<future<void>> closing;
+        for (auto& s : shards) closing.push_back(s.worker->submit([&s]() { s.system.reset(); }));
+        for (auto& f : closing) f.get();
+    }
+
+    ShardedReservationSystem(const ShardedReservationSystem&) = delete;
+    ShardedReservationSystem& operator=(const ShardedReservationSystem&) = delete;
+
+    size_t shardCount() const { return shards.size(); }
+
+    void setCommitWindow(chrono::microseconds window) {
+        for (auto& s : shards) s.system->setCommitWindow(window);
+    }
+
+    // Registered on shard 0, which checks the email, then copied to the rest.
+    OperationResult registerPassenger(const string& name, const string& email, const string& phone,
+                                      const string& passport, const string& password) {
+        OperationResult result = onShard(0, [&](ReservationSystem& system) {
+            return system.registerPassenger(name, email, phone, passport, password);
+        });
+        if (!result.success || shards.size() == 1) return result;
+        Passenger registered = *shard(0).findPassenger(result.id);
+        vector<future<uint64_t>> copies;
+        for (size_t k = 1; k < shards.size(); k++) {
+            ReservationSystem& system = shard(k);
+            copies.push_back(shards[k].worker->submit([&system, &registered]() {
+                ReservationSystem::DeferredSync deferred(system);
+                system.importPassenger(registered);
+                return deferred.sequence();
+            }));
+        }
+        for (size_t k = 1; k < shards.size(); k++) {
+            if (!shard(k).syncJournal(copies[k - 1].get())) ReservationSystem::markUnsaved(result);
+        }
+        return result;
+    }
+
+    Passenger* authenticatePassenger(const string& userId, const string& password) {
+        return shard(0).authenticatePassenger(userId, password);
+    }
+
+    OperationResult addFlight(const Flight& flight) {
+        return onShard(shardOf(flight.getFlightNumber()),
+                       [&](ReservationSystem& system) { return system.addFlight(flight); });
+    }
+
+    OperationResult removeFlight(const string& flightNumber) {
+        return onShard(shardOf(flightNumber),
+                       [&](ReservationSystem& system) { return system.removeFlight(flightNumber); });
+    }
+
+    BookingResult book(const string& passengerId, const string& flightNumber, const string& seat) {
+        size_t k = shardOf(flightNumber);
+        BookingResult result = onShard(k, [&](ReservationSystem& system) {
+            return system.book(passengerId, flightNumber, seat);
+        });
+        remember(result, k);
+        return result;
+    }
+
+    BookingResult autoBook(const string& passengerId, const string& flightNumber,
+                           const SeatPreference& preference = SeatPreference()) {
+        size_t k = shardOf(flightNumber);
+        BookingResult result = onShard(k, [&](ReservationSystem& system) {
+            return system.autoBook(passengerId, flightNumber, preference);
+        });
+        remember(result, k);
+        return result;
+    }
+
+    BookingResult cancel(const string& bookingId, const string& passengerId = "") {
+        int32_t key;
+        uint32_t k;
+        if (lookupBookingId(bookingId, key) && bookingShards.get(key, k)) {
+            return onShard(k, [&](ReservationSystem& system) { return system.cancel(bookingId, passengerId); });
+        }
+        vector<BookingResult> results = onAllShards([&](ReservationSystem& system) {
+            return system.cancel(bookingId, passengerId);
+        });
+        for (const BookingResult& result : results) {
+            if (result.success) return result;
+        }
+        return results.front();
+    }
+
+    // Open flights first, each group in departure-time order, as on one system.
+    vector<Flight> searchFlights(const FlightQuery& query) {
+        vector<Flight> result;
+        for (auto& s : shards) {
+            vector<Flight> found = s.system->searchFlights(query);
+            result.insert(result.end(), make_move_iterator(found.begin()), make_move_iterator(found.end()));
+        }
+        stable_sort(result.begin(), result.end(), [](const Flight& a, const Flight& b) {
+            bool aOpen = a.getAvailableSeatsCount() > 0, bOpen = b.getAvailableSeatsCount() > 0;
+            return aOpen != bOpen ? aOpen : a.getDepartureTime() < b.getDepartureTime();
+        });
+        return result;
+    }
+
+    vector<Flight> listFlights() {
+        vector<Flight> result;
+        for (auto& s : shards) {
+            vector<Flight> part = s.system->listFlights();
+            result.insert(result.end(), make_move_iterator(part.begin()), make_move_iterator(part.end()));
+        }
+        return result;
+    }
+
+    bool getFlight(const string& flightNumber, Flight& out) {
+        return shard(shardOf(flightNumber)).getFlight(flightNumber, out);
+    }
+
+    vector<Booking> bookingsForPassenger(const string& passengerId) {
+        return bookingsForPassenger(passengerId, "", 0, numeric_limits<size_t>::max()).bookings;
+    }
+
+    // Each shard supplies its first offset + limit bookings from fromDate;
+    // the page is cut from their merge by booking date.
+    BookingPage bookingsForPassenger(const string& passengerId, const string& fromDate,
+                                     size_t offset, size_t limit) {
+        size_t wanted = limit > numeric_limits<size_t>::max() - offset ? limit : offset + limit;
+        BookingPage result;
+        result.total = 0;
+        for (auto& s : shards) {
+            BookingPage part = s.system->bookingsForPassenger(passengerId, fromDate, 0, wanted);
+            result.total += part.total;
+            size_t middle = result.bookings.size();
+            result.bookings.insert(result.bookings.end(), make_move_iterator(part.bookings.begin()),
+                                   make_move_iterator(part.bookings.end()));
+            inplace_merge(result.bookings.begin(), result.bookings.begin() + middle, result.bookings.end(),
+                          [](const Booking& a, const Booking& b) { return a.getBookingDay() < b.getBookingDay(); });
+        }
+        size_t from = min(offset, result.bookings.size());
+        size_t to = min(wanted, result.bookings.size());
+        result.bookings = vector<Booking>(make_move_iterator(result.bookings.begin() + from),
+                                          make_move_iterator(result.bookings.begin() + to));
+        return result;
+    }
+
+    size_t bookingCount(const string& passengerId) {
+        size_t count = 0;
+        for (auto& s : shards) count += s.system->bookingCount(passengerId);
+        return count;
+    }
+
+    vector<FlightOccupancy> flightOccupancy() {
+        vector<FlightOccupancy> result;
+        for (auto& s : shards) {
+            vector<FlightOccupancy> part = s.system->flightOccupancy();
+            result.insert(result.end(), part.begin(), part.end());
+        }
+        return result;
+    }
+
+    // Sums the shards' totals and re-ranks routes and airlines over all of
+    // them; a route can be flown by flights on several shards.
+    SystemReport generateReport(size_t topRoutes = 5) {
+        SystemReport report = {0, 0, 0, 0, 0, 0, 0, 0.0, {}, {}};
+        map<string, int> routes;
+        map<string, SalesTotals> airlines;
+        for (auto& s : shards) {
+            SystemReport part = s.system->generateReport(numeric_limits<size_t>::max());
+            report.totalPassengers = max(report.totalPassengers, part.totalPassengers);  // on every shard
+            report.totalFlights += part.totalFlights;
+            report.totalBookings += part.totalBookings;
+            report.confirmedBookings += part.confirmedBookings;
+            report.cancelledBookings += part.cancelledBookings;
+            report.totalSeats += part.totalSeats;
+            report.bookedSeats += part.bookedSeats;
+            report.totalRevenue += part.totalRevenue;
+            for (const auto& route : part.topRoutes) routes[route.first] += route.second;
+            for (const auto& airline : part.airlines) {
+                SalesTotals& totals = airlines[airline.first];
+                totals.confirmed += airline.second.confirmed;
+                totals.cancelled += airline.second.cancelled;
+                totals.revenue += airline.second.revenue;
+            }
+        }
+        
+        report.topRoutes.assign(routes.begin(), routes.end());
+        sort(report.topRoutes.begin(), report.topRoutes.end(),
+             [](const pair<string, int>& a, const pair<string, int>& b) {
+                 return a.second != b.second ? a.second > b.second : a.first < b.first;
+             });
+        if (report.topRoutes.size() > topRoutes) report.topRoutes.resize(topRoutes);
+        report.airlines.assign(airlines.begin(), airlines.end());
+        sort(report.airlines.begin(), report.airlines.end(),
+             [](const pair<string, SalesTotals>& a, const pair<string, SalesTotals>& b) {
+                 return a.second.revenue != b.second.revenue ? a.second.revenue > b.second.revenue
+                                                             : a.first < b.first;
+             });
+        return report;
+    }
+
+    // True when every shard's snapshot was written.
+    bool saveAllData() {
+        vector<bool> saved = onAllShards([](ReservationSystem& system) { return system.saveAllData(); });
+        return find(saved.begin(), saved.end(), false) == saved.end();
+    }
+};
+
+ 
+// Built without main() when another target (the benchmark) includes this file.
+#ifndef ARS_NO_MAIN
+int main(int argc, char* argv[]) {
+    try {
+        ReservationSystem system;
+        string option = argc > 1 ? argv[1] : "";
+        if (option == "--bench-startup") {
+            system.benchmarkStartup(argc > 2 ? max(1, atoi(argv[2])) : 5);
+            return 0;
+        }
+        if (option == "--bench-reports") {
+            system.benchmarkReports(argc > 2 ? max(1, atoi(argv[2])) : 10);
+            return 0;
+        }
+        if (option == "--analytics") {
+            system.printRevenueAnalytics();
+            return 0;
+        }
+        if (option == "--metrics") {
+            // Prints the counters accumulated while loading the snapshot.
+            return system.exportMetrics(argc > 2 ? argv[2] : "") ? 0 : 1;
+        }
+        if (option == "--convert-to-binary" || option == "--convert-to-text") {
+            bool binary = option == "--convert-to-binary";
+            system.setSnapshotFormat(binary ? SnapshotFormat::Binary : SnapshotFormat::Text);
+            if (!system.saveAllData()) {
+                cerr << "ERROR: Snapshot could not be written" << endl;
+                return 1;
+            }
+            cout << "Snapshot converted to " << (binary ? "snapshot.bin" : "text files") << endl;
+            return 0;
+        }
+        system.run();
+    } catch (const exception& e) {
+        cerr << "\nERROR: System Error: " << e.what() << endl;
+        return 1;
+    }
+    
+    return 0;
+}
+#endif
@@ -0,0 +1,420 @@
+// Benchmark for the reservation core. Generates a synthetic data set in a
+// scratch directory, then times load, save, login, search, book, cancel,
+// batch booking and the reports through ReservationSystem's headless API.
+// With --shards N it then repeats booking and search on a
+// ShardedReservationSystem driven by N client threads.
+//
+//   ars_benchmark [--bookings 100k] [--ops 10000] [--dir bench_data]
+//                 [--format json|csv] [--seed 1] [--metrics file] [--shards N]
+//                 [--commit-window-us 0]
+//
+// Results go to stdout (JSON by default), progress to stderr.
+
+#define ARS_NO_MAIN
+#include "../Airline_Reservation_System.cc"
+
+#include <filesystem>
+#include <random>
+
+struct BenchConfig {
+    size_t bookings = 100000;
+    size_t ops = 10000;
+    string dir = "bench_data";
+    string format = "json";
+    unsigned seed = 1;
+    string metrics;
+    size_t shards = 0;
+    long commitWindowUs = 0;
+};
+
+struct BenchScale {
+    size_t passengers;
+    size_t flights;
+    size_t cities;
+    int rows;
+};
+
+struct OpStats {
+    string name;
+    size_t count;
+    size_t failed;
+    double totalMs;
+    double p50Us;
+    double p99Us;
+    double maxUs;
+};
+
+// Accepts plain counts and k/M suffixes ("1k", "10M").
+size_t parseScale(const string& text) {
+    if (text.empty()) return 0;
+    size_t multiplier = 1;
+    string digits = text;
+    char suffix = (char)tolower((unsigned char)text.back());
+    if (suffix == 'k') multiplier = 1000;
+    if (suffix == 'm') multiplier = 1000000;
+    if (multiplier > 1) digits.pop_back();
+    return (size_t)strtoull(digits.c_str(), nullptr, 10) * multiplier;
+}
+
+// Roughly 10 bookings per passenger and 500 per flight, with every flight
+// at most five-sixths full so the booking phase always finds free seats.
+BenchScale scaleFor(size_t bookings) {
+    BenchScale scale;
+    scale.passengers = max<size_t>(100, bookings / 10);
+    scale.flights = max<size_t>(50, bookings / 500);
+    scale.cities = 50;
+    size_t perFlight = (bookings + scale.flights - 1) / scale.flights;
+    scale.rows = (int)max<size_t>(10, (perFlight * 6 / 5 + SeatInventory::columns() - 1) / SeatInventory::columns());
+    return scale;
+}
+
+string cityName(size_t i) { return "City" + to_string(i); }
+
+string flightNumberOf(size_t i) { return "BF" + to_string(100000 + i); }
+
+string passengerIdOf(size_t i) { return "P" + to_string(1000 + i); }
+
+string flightDateOf(size_t i) { return to_string(1 + i % 28) + "/11/2030"; }
+
+// Writes the four text files the way saveAllData() would. Booking IDs start
+// above the passenger IDs so generateId() continues past both.
+void generateData(const BenchConfig& config, const BenchScale& scale) {
+    mt19937 rng(config.seed);
+
+    ofstream admins("admins.txt");
+    admins << Admin("admin", "admin123", "Bench Admin", "admin@airline.com", "SUPER").toFileString() << "\n";
+
+    ofstream passengers("passengers.txt");
+    for (size_t i = 0; i < scale.passengers; i++) {
+        passengers << Passenger(passengerIdOf(i), "pass" + to_string(i), "Passenger " + to_string(i),
+                                "p" + to_string(i) + "@example.com", "9000000000",
+                                "X" + to_string(i)).toFileString() << "\n";
+    }
+
+    vector<Flight> flights;
+    flights.reserve(scale.flights);
+    for (size_t i = 0; i < scale.flights; i++) {
+        size_t origin = rng() % scale.cities;
+        size_t destination = (origin + 1 + rng() % (scale.cities - 1)) % scale.cities;
+        int departs = (int)(rng() % (20 * 60));
+        flights.push_back(Flight(flightNumberOf(i), "Airline" + to_string(i % 8), cityName(origin),
+                                 cityName(destination), flightDateOf(i), formatMinutes(departs),
+                                 formatMinutes(departs + 60 + (int)(rng() % 180)),
+                                 scale.rows * SeatInventory::columns(), 2000 + rng() % 8000));
+    }
+
+    ofstream bookings("bookings.txt");
+    size_t bookingBase = 1000 + scale.passengers;
+    for (size_t i = 0; i < config.bookings; i++) {
+        size_t f = i % scale.flights;
+        string seat = SeatInventory::formatSeat((int)(i / scale.flights));
+        flights[f].bookSeat(seat);
+        Booking b("TXN" + to_string(bookingBase + i), passengerIdOf(rng() % scale.passengers),
+                  flights[f].getFlightNumber(), seat, flights[f].getBaseFare());
+        if (rng() % 10 == 0) {
+            b.setStatus("CANCELLED");
+            flights[f].cancelSeat(seat);
+        }
+        bookings << b.toFileString() << "\n";
+    }
+
+    ofstream flightFile("flights.txt");
+    for (const auto& f : flights) flightFile << f.toFileString() << "\n";
+}
+
+class LatencyRecorder {
+private:
+    typedef chrono::steady_clock Clock;
+    string name;
+    vector<double> samplesUs;
+    size_t failed;
+
+public:
+    explicit LatencyRecorder(const string& opName) : name(opName), failed(0) {}
+
+    template <typename Op>
+    void time(Op op) {
+        Clock::time_point start = Clock::now();
+        bool ok = op();
+        samplesUs.push_back(chrono::duration<double, micro>(Clock::now() - start).count());
+        if (!ok) failed++;
+    }
+
+    void merge(const LatencyRecorder& other) {
+        samplesUs.insert(samplesUs.end(), other.samplesUs.begin(), other.samplesUs.end());
+        failed += other.failed;
+    }
+
+    OpStats stats() const {
+        OpStats result = {name, samplesUs.size(), failed, 0.0, 0.0, 0.0, 0.0};
+        if (samplesUs.empty()) return result;
+        vector<double> sorted(samplesUs);
+        sort(sorted.begin(), sorted.end());
+        for (double us : sorted) result.totalMs += us / 1000.0;
+        auto percentile = [&](double p) {
+            size_t rank = (size_t)ceil(p * sorted.size());
+            return sorted[min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+        };
+        result.p50Us = percentile(0.50);
+        result.p99Us = percentile(0.99);
+        result.maxUs = sorted.back();
+        return result;
+    }
+};
+
+void printResults(const BenchConfig& config, const BenchScale& scale, const vector<OpStats>& results) {
+    cout << fixed << setprecision(3);
+    if (config.format == "csv") {
+        cout << "op,count,failed,total_ms,ops_per_sec,p50_us,p99_us,max_us" << endl;
+        for (const auto& r : results) {
+            cout << r.name << "," << r.count << "," << r.failed << "," << r.totalMs << ","
+                 << (r.totalMs > 0 ? r.count * 1000.0 / r.totalMs : 0.0) << ","
+                 << r.p50Us << "," << r.p99Us << "," << r.maxUs << endl;
+        }
+        return;
+    }
+    cout << "{\"bookings\":" << config.bookings << ",\"passengers\":" << scale.passengers
+         << ",\"flights\":" << scale.flights << ",\"ops\":" << config.ops
+         << ",\"simd\":\"" << simdLevelName(activeSimdLevel()) << "\",\"results\":[";
+    for (size_t i = 0; i < results.size(); i++) {
+        const OpStats& r = results[i];
+        cout << (i ? "," : "") << "\n  {\"op\":\"" << r.name << "\",\"count\":" << r.count
+             << ",\"failed\":" << r.failed << ",\"total_ms\":" << r.totalMs
+             << ",\"ops_per_sec\":" << (r.totalMs > 0 ? r.count * 1000.0 / r.totalMs : 0.0)
+             << ",\"p50_us\":" << r.p50Us << ",\"p99_us\":" << r.p99Us << ",\"max_us\":" << r.maxUs << "}";
+    }
+    cout << "\n]}" << endl;
+}
+
+// Runs ops operations split across threads clients, each timing its own;
+// total_ms is the wall time of the whole run, so ops_per_sec is the
+// combined throughput.
+template <typename Op>
+OpStats timeConcurrently(const string& name, size_t clients, size_t ops, Op op) {
+    vector<LatencyRecorder> recorders(clients, LatencyRecorder(name));
+    vector<thread> threads;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (size_t c = 0; c < clients; c++) {
+        threads.emplace_back([&, c]() {
+            mt19937 rng((unsigned)c + 7);
+            for (size_t i = c; i < ops; i += clients) recorders[c].time([&]() { return op(rng); });
+        });
+    }
+    for (auto& t : threads) t.join();
+    double wallMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    for (size_t c = 1; c < clients; c++) recorders[0].merge(recorders[c]);
+    OpStats stats = recorders[0].stats();
+    stats.totalMs = wallMs;
+    return stats;
+}
+
+// The schedule is re-created empty in <dir>/sharded; every shard starts
+// with all the passengers.
+void runShardedBenchmark(const BenchConfig& config, const BenchScale& scale,
+                         const vector<Flight>& schedule, vector<OpStats>& results) {
+    filesystem::remove_all("sharded");
+    filesystem::create_directories("sharded");
+    for (size_t k = 0; k < config.shards; k++) {
+        filesystem::create_directories("sharded/shard-" + to_string(k));
+        filesystem::copy_file("passengers.txt", "sharded/shard-" + to_string(k) + "/passengers.txt");
+    }
+    ShardedReservationSystem system("sharded", config.shards);
+    system.setCommitWindow(chrono::microseconds(config.commitWindowUs));
+    for (const Flight& f : schedule) {
+        system.addFlight(Flight(f.getFlightNumber(), f.getAirline(), f.getOrigin(), f.getDestination(),
+                                f.getDepartureDate(), f.getDepartureTime(), f.getArrivalTime(),
+                                f.getTotalSeats(), f.getBaseFare()));
+    }
+
+    cerr << "sharded book (" << config.shards << " shards)" << endl;
+    results.push_back(timeConcurrently("sharded_book", config.shards, config.ops, [&](mt19937& rng) {
+        const Flight& f = schedule[rng() % schedule.size()];
+        return system.autoBook(passengerIdOf(rng() % scale.passengers), f.getFlightNumber()).success;
+    }));
+
+    cerr << "sharded search" << endl;
+    results.push_back(timeConcurrently("sharded_search", config.shards, config.ops, [&](mt19937& rng) {
+        const Flight& f = schedule[rng() % schedule.size()];
+        FlightQuery query;
+        query.origin = f.getOrigin();
+        query.destination = f.getDestination();
+        query.date = f.getDepartureDate();
+        return !system.searchFlights(query).empty();
+    }));
+
+    LatencyRecorder report("sharded_report");
+    for (int i = 0; i < 20; i++) report.time([&]() { return system.generateReport().totalFlights > 0; });
+    results.push_back(report.stats());
+}
+
+int runBenchmark(const BenchConfig& config) {
+    BenchScale scale = scaleFor(config.bookings);
+    filesystem::create_directories(config.dir);
+    filesystem::current_path(config.dir);
+    for (const char* stale : {"journal.log", "snapshot.bin"}) remove(stale);
+
+    cerr << "Generating " << config.bookings << " bookings, " << scale.passengers << " passengers, "
+         << scale.flights << " flights in " << config.dir << endl;
+    generateData(config, scale);
+
+    vector<OpStats> results;
+    mt19937 rng(config.seed + 1);
+    unique_ptr<ReservationSystem> system;
+
+    cerr << "load" << endl;
+    LatencyRecorder load("load");
+    load.time([&]() {
+        system.reset(new ReservationSystem());
+        system->setCommitWindow(chrono::microseconds(config.commitWindowUs));
+        return true;
+    });
+    results.push_back(load.stats());
+
+    cerr << "save" << endl;
+    LatencyRecorder save("save");
+    for (int i = 0; i < 3; i++) save.time([&]() { system->saveAllData(); return true; });
+    results.push_back(save.stats());
+
+    cerr << "login" << endl;
+    LatencyRecorder login("login");
+    for (size_t i = 0; i < config.ops; i++) {
+        size_t p = rng() % scale.passengers;
+        login.time([&]() { return system->authenticatePassenger(passengerIdOf(p), "pass" + to_string(p)) != nullptr; });
+    }
+    results.push_back(login.stats());
+
+    // Queries for routes that exist, on the flight's own day.
+    vector<Flight> schedule = system->listFlights();
+    cerr << "search" << endl;
+    LatencyRecorder search("search");
+    for (size_t i = 0; i < config.ops; i++) {
+        const Flight& f = schedule[rng() % schedule.size()];
+        FlightQuery query;
+        query.origin = f.getOrigin();
+        query.destination = f.getDestination();
+        query.date = f.getDepartureDate();
+        search.time([&]() { return !system->searchFlights(query).empty(); });
+    }
+    results.push_back(search.stats());
+
+    cerr << "connections" << endl;
+    LatencyRecorder connections("search_connections");
+    for (size_t i = 0; i < config.ops / 10 + 1; i++) {
+        const Flight& f = schedule[rng() % schedule.size()];
+        ConnectionQuery query;
+        query.origin = f.getOrigin();
+        query.destination = cityName(rng() % scale.cities);
+        query.date = f.getDepartureDate();
+        connections.time([&]() { system->searchConnections(query); return true; });
+    }
+    results.push_back(connections.stats());
+
+    // Seats are drawn from each flight's free list at load time and removed
+    // as they are booked, so every attempt targets a free seat.
+    cerr << "book" << endl;
+    LatencyRecorder book("book");
+    vector<string> made;
+    unordered_map<size_t, vector<string>> freeSeats;
+    for (size_t i = 0; i < config.ops; i++) {
+        size_t index = rng() % schedule.size();
+        const Flight& f = schedule[index];
+        auto it = freeSeats.find(index);
+        if (it == freeSeats.end()) it = freeSeats.emplace(index, f.getAvailableSeats()).first;
+        vector<string>& free = it->second;
+        string seat = "A1";
+        if (!free.empty()) {
+            swap(free[rng() % free.size()], free.back());
+            seat = free.back();
+            free.pop_back();
+        }
+        string passenger = passengerIdOf(rng() % scale.passengers);
+        book.time([&]() {
+            BookingResult r = system->book(passenger, f.getFlightNumber(), seat);
+            if (r.success) made.push_back(r.booking.getBookingId());
+            return r.success;
+        });
+    }
+    results.push_back(book.stats());
+
+    cerr << "cancel" << endl;
+    LatencyRecorder cancel("cancel");
+    for (const string& bookingId : made) {
+        cancel.time([&]() { return system->cancel(bookingId).success; });
+    }
+    results.push_back(cancel.stats());
+
+    // Group bookings of up to 50 adjacent seats, each one journal write.
+    cerr << "book_batch" << endl;
+    LatencyRecorder bookBatch("book_batch_50");
+    for (size_t i = 0; i < config.ops / 50 + 1; i++) {
+        Flight f;
+        system->getFlight(schedule[rng() % schedule.size()].getFlightNumber(), f);
+        int group = min(50, f.getAvailableSeatsCount());
+        if (group == 0) continue;
+        string passenger = passengerIdOf(rng() % scale.passengers);
+        bookBatch.time([&]() {
+            return system->bookBatch(passenger, {BatchLeg{f.getFlightNumber(), group, {}}}).success;
+        });
+    }
+    results.push_back(bookBatch.stats());
+
+    // The columnar mirror is built on first use; time that once, apart from
+    // the steady-state report calls.
+    cerr << "reports" << endl;
+    LatencyRecorder analyticsBuild("analytics_build");
+    analyticsBuild.time([&]() { return system->analytics().rows() > 0; });
+    results.push_back(analyticsBuild.stats());
+
+    LatencyRecorder report("report");
+    LatencyRecorder occupancy("occupancy");
+    LatencyRecorder revenue("revenue_by_route");
+    for (int i = 0; i < 20; i++) {
+        report.time([&]() { system->generateReport(); return true; });
+        occupancy.time([&]() { return !system->flightOccupancy().empty(); });
+        revenue.time([&]() { return !system->analytics().revenueByRoute().empty(); });
+    }
+    results.push_back(report.stats());
+    results.push_back(occupancy.stats());
+    results.push_back(revenue.stats());
+
+    if (config.shards > 0) runShardedBenchmark(config, scale, schedule, results);
+
+    printResults(config, scale, results);
+    if (!config.metrics.empty() && !system->exportMetrics(config.metrics)) {
+        cerr << "ERROR: Could not write " << config.metrics << endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        string value = i + 1 < argc ? argv[i + 1] : "";
+        if (arg == "--bookings") config.bookings = parseScale(value);
+        else if (arg == "--ops") config.ops = parseScale(value);
+        else if (arg == "--dir") config.dir = value;
+        else if (arg == "--format") config.format = value;
+        else if (arg == "--seed") config.seed = (unsigned)atoi(value.c_str());
+        else if (arg == "--metrics") config.metrics = value;
+        else if (arg == "--shards") config.shards = parseScale(value);
+        else if (arg == "--commit-window-us") config.commitWindowUs = atol(value.c_str());
+        else {
+            cerr << "Usage: " << argv[0] << " [--bookings N] [--ops N] [--dir path] [--format json|csv] [--seed N] [--metrics file] [--shards N] [--commit-window-us N]" << endl;
+            return 2;
+        }
+        i++;
+    }
+    if (config.bookings == 0 || config.ops == 0) {
+        cerr << "ERROR: --bookings and --ops must be positive" << endl;
+        return 2;
+    }
+
+    try {
+        return runBenchmark(config);
+    } catch (const exception& e) {
+        cerr << "\nERROR: Benchmark failed: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -0,0 +1,681 @@
+// Behavioral tests for the reservation core, driven through the headless
+// API. Each case works in its own scratch directory under test_data/.
+//
+//   reservation_tests [case]      (no case runs them all)
+//
+// Prints one line per failed check and exits non-zero if any failed.
+
+#define ARS_NO_MAIN
+#include "../Airline_Reservation_System.cc"
+
+#include <filesystem>
+#include <random>
+#include <set>
+
+#ifndef _WIN32
+    #include <csignal>
+    #include <sys/resource.h>
+    #include <sys/wait.h>
+#endif
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                  \
+    do {                                                                                  \
+        if (!(condition)) {                                                               \
+            cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << endl; \
+            failures++;                                                                   \
+        }                                                                                 \
+    } while (0)
+
+static string scratchDir(const string& name) {
+    string dir = "test_data/" + name;
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    return dir;
+}
+
+static Passenger testPassenger(const string& id) {
+    return Passenger(id, "pass", "Test " + id, id + "@example.com", "9876543210", "PP" + id);
+}
+
+static Flight testFlight(const string& number, const string& origin, const string& destination,
+                         const string& date, const string& departure, int seats = 60) {
+    return Flight(number, "Test Air", origin, destination, date, departure, "23:00", seats, 1000.0);
+}
+
+static bool seatFree(ReservationSystem& system, const string& flightNumber, const string& seat) {
+    Flight f;
+    if (!system.getFlight(flightNumber, f)) return false;
+    vector<string> free = f.getAvailableSeats();
+    return find(free.begin(), free.end(), seat) != free.end();
+}
+
+// Every confirmed booking holds its seat and every taken seat belongs to a
+// confirmed booking.
+static void checkSeatMap(ReservationSystem& system, const string& passengerId) {
+    map<string, set<string>> booked;
+    for (const Booking& b : system.bookingsForPassenger(passengerId)) {
+        if (b.isConfirmed()) CHECK(booked[b.getFlightNumber()].insert(b.getSeatNumber()).second);
+    }
+    for (const Flight& f : system.listFlights()) {
+        const set<string>& seats = booked[f.getFlightNumber()];
+        CHECK((int)seats.size() == f.getTotalSeats() - f.getAvailableSeatsCount());
+        for (const string& seat : seats) CHECK(!seatFree(system, f.getFlightNumber(), seat));
+    }
+}
+
+static string seatMap(ReservationSystem& system) {
+    string out;
+    for (const Flight& f : system.listFlights()) {
+        out += f.getFlightNumber() + ":";
+        for (const string& seat : f.getAvailableSeats()) out += seat + ",";
+        out += "\n";
+    }
+    return out;
+}
+
+// Books and cancels past several checkpoints in a child process that then
+// dies without saving, possibly with a background checkpoint half written;
+// reloading must give the child's last acknowledged state.
+static void testCrashReplay() {
+#ifdef _WIN32
+    cout << "crash_replay: skipped (needs fork)" << endl;
+#else
+    string dir = scratchDir("crash_replay");
+    pid_t child = fork();
+    if (child == 0) {
+        ReservationSystem system(dir, false);
+        system.importPassenger(testPassenger("P1000"));
+        for (int i = 0; i < 10; i++) {
+            system.addFlight(testFlight("CR" + to_string(i), "Pune", "Goa", "01/11/2030", "10:00"));
+        }
+        for (int i = 0; i < 2500; i++) {
+            BookingResult result = system.autoBook("P1000", "CR" + to_string(i % 10));
+            if (result.success && i % 2 == 0) system.cancel(result.booking.getBookingId());
+        }
+        ofstream(dir + "/expected.txt") << system.bookingCount("P1000") << "\n" << seatMap(system);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    ifstream expectedFile(dir + "/expected.txt");
+    string expected((istreambuf_iterator<char>(expectedFile)), istreambuf_iterator<char>());
+    ReservationSystem system(dir, false);
+    CHECK(!expected.empty());
+    CHECK(to_string(system.bookingCount("P1000")) + "\n" + seatMap(system) == expected);
+    checkSeatMap(system, "P1000");
+#endif
+}
+
+// A change the journal cannot write is saved by a full snapshot instead,
+// and reported as failed only when that cannot be written either. Writes
+// are made to fail with a file size limit, in a child that then dies
+// without saving.
+static void testUnsavedChange() {
+#ifdef _WIN32
+    cout << "unsaved_change: skipped (needs fork)" << endl;
+#else
+    string dir = scratchDir("unsaved_change");
+    pid_t child = fork();
+    if (child == 0) {
+        ReservationSystem system(dir, false);
+        system.importPassenger(testPassenger("P1000"));
+        system.addFlight(testFlight("US1", "Pune", "Goa", "01/11/2030", "10:00"));
+        CHECK(system.saveAllData());
+
+        signal(SIGXFSZ, SIG_IGN);
+        rlimit normal;
+        getrlimit(RLIMIT_FSIZE, &normal);
+        rlimit tiny = normal;
+        tiny.rlim_cur = 16;
+        setrlimit(RLIMIT_FSIZE, &tiny);
+        BookingResult result = system.book("P1000", "US1", "A1");
+        CHECK(!result.success && result.error == ReservationSystem::UNSAVED_ERROR);
+        setrlimit(RLIMIT_FSIZE, &normal);
+
+        CHECK(system.book("P1000", "US1", "A2").success);  // by snapshot; the journal had a gap
+        CHECK(system.book("P1000", "US1", "A3").success);  // by the fresh journal
+        _exit(failures ? 1 : 0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    ReservationSystem system(dir, false);
+    CHECK(system.bookingCount("P1000") == 3);
+    CHECK(!seatFree(system, "US1", "A1") && !seatFree(system, "US1", "A2") && !seatFree(system, "US1", "A3"));
+    checkSeatMap(system, "P1000");
+#endif
+}
+
+// A "G|n" group cut short by a crash is dropped whole; the records before
+// it still apply.
+static void testTornGroup() {
+    string source = scratchDir("torn_group_source");
+    string target = scratchDir("torn_group");
+    {
+        ReservationSystem system(source, false);
+        system.importPassenger(testPassenger("P1000"));
+        system.addFlight(testFlight("TG1", "Pune", "Goa", "01/11/2030", "10:00"));
+    }
+    filesystem::copy(source, target,
+                     filesystem::copy_options::recursive | filesystem::copy_options::overwrite_existing);
+
+    vector<string> records;
+    {
+        ReservationSystem system(source, false);
+        CHECK(system.book("P1000", "TG1", "A1").success);
+        CHECK(system.book("P1000", "TG1", "B1").success);
+        CHECK(system.book("P1000", "TG1", "C1").success);
+        ifstream journal(source + "/journal.log");
+        string line;
+        while (getline(journal, line)) records.push_back(line);
+    }
+    CHECK(records.size() == 3);
+    if (records.size() != 3) return;
+    ofstream(target + "/journal.log") << records[0] << "\nG|2\n" << records[1] << "\n" << records[2];
+
+    ReservationSystem system(target, false);
+    CHECK(system.bookingCount("P1000") == 1);
+    CHECK(!seatFree(system, "TG1", "A1"));
+    CHECK(seatFree(system, "TG1", "B1"));
+    CHECK(seatFree(system, "TG1", "C1"));
+}
+
+// Sets up P1000 and TG1 in target, and returns the journal lines for
+// booking A1 and B1 on a copy of it.
+static vector<string> bookedRecords(const string& sourceName, const string& target) {
+    string source = scratchDir(sourceName);
+    {
+        ReservationSystem system(source, false);
+        system.importPassenger(testPassenger("P1000"));
+        system.addFlight(testFlight("TG1", "Pune", "Goa", "01/11/2030", "10:00"));
+    }
+    filesystem::copy(source, target,
+                     filesystem::copy_options::recursive | filesystem::copy_options::overwrite_existing);
+
+    vector<string> records;
+    ReservationSystem system(source, false);
+    CHECK(system.book("P1000", "TG1", "A1").success);
+    CHECK(system.book("P1000", "TG1", "B1").success);
+    ifstream journal(source + "/journal.log");
+    string line;
+    while (getline(journal, line)) records.push_back(line);
+    CHECK(records.size() == 2);
+    return records;
+}
+
+// Restarts on dir, books seat on TG1 and dies without saving, so the
+// booking is only in the journal.
+static void bookAndCrash(const string& dir, const string& seat) {
+#ifndef _WIN32
+    pid_t child = fork();
+    if (child == 0) {
+        ReservationSystem system(dir, false);
+        _exit(system.book("P1000", "TG1", seat).success ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+#endif
+}
+
+// A torn last line is cut off at startup, so the next record does not get
+// glued onto it and lost.
+static void testTornAppend() {
+#ifdef _WIN32
+    cout << "torn_append: skipped (needs fork)" << endl;
+#else
+    string target = scratchDir("torn_append");
+    vector<string> records = bookedRecords("torn_append_source", target);
+    if (records.size() != 2) return;
+    ofstream(target + "/journal.log") << records[0] << "\n" << records[1].substr(0, 9);
+
+    bookAndCrash(target, "D1");
+    ReservationSystem system(target, false);
+    CHECK(system.bookingCount("P1000") == 2);
+    CHECK(!seatFree(system, "TG1", "A1"));
+    CHECK(seatFree(system, "TG1", "B1"));
+    CHECK(!seatFree(system, "TG1", "D1"));
+#endif
+}
+
+// A group torn at the end of the log is cut off at startup, so the next
+// record is not taken for its missing member and the group stays dropped.
+static void testTornGroupAppend() {
+#ifdef _WIN32
+    cout << "torn_group_append: skipped (needs fork)" << endl;
+#else
+    string target = scratchDir("torn_group_append");
+    vector<string> records = bookedRecords("torn_group_append_source", target);
+    if (records.size() != 2) return;
+    ofstream(target + "/journal.log") << records[0] << "\nG|2\n" << records[1] << "\n";
+
+    bookAndCrash(target, "D1");
+    for (int restart = 0; restart < 2; restart++) {
+        ReservationSystem system(target, false);
+        CHECK(system.bookingCount("P1000") == 2);
+        CHECK(!seatFree(system, "TG1", "A1"));
+        CHECK(seatFree(system, "TG1", "B1"));
+        CHECK(!seatFree(system, "TG1", "D1"));
+    }
+#endif
+}
+
+// A batch that fails on its last seat leaves no seat taken and no booking,
+// in memory and after a restart.
+static void testBatchRollback() {
+    string dir = scratchDir("batch_rollback");
+    string before;
+    {
+        ReservationSystem system(dir, false);
+        system.importPassenger(testPassenger("P1000"));
+        system.addFlight(testFlight("BR1", "Pune", "Goa", "01/11/2030", "10:00"));
+        system.addFlight(testFlight("BR2", "Goa", "Pune", "02/11/2030", "10:00"));
+        CHECK(system.book("P1000", "BR2", "A2").success);
+        before = seatMap(system);
+
+        vector<BatchLeg> legs = {{"BR1", 3, {}}, {"BR2", 0, {"A1", "A2"}}};
+        BatchBookingResult result = system.bookBatch("P1000", legs);
+        CHECK(!result.success);
+        CHECK(result.bookings.empty());
+        CHECK(seatMap(system) == before);
+        CHECK(system.bookingCount("P1000") == 1);
+
+        legs = {{"BR1", 3, {}}, {"BR2", 0, {"A1", "B1"}}};
+        CHECK(system.bookBatch("P1000", legs).success);
+        CHECK(system.bookingCount("P1000") == 6);
+        before = seatMap(system);
+    }
+    ReservationSystem system(dir, false);
+    CHECK(seatMap(system) == before);
+    CHECK(system.bookingCount("P1000") == 6);
+    checkSeatMap(system, "P1000");
+}
+
+// A hold blocks its seat until it lapses; confirming it afterwards fails
+// and the seat is free again.
+static void testHoldExpiry() {
+    string dir = scratchDir("hold_expiry");
+    ReservationSystem system(dir, false);
+    system.importPassenger(testPassenger("P1000"));
+    system.addFlight(testFlight("HX1", "Pune", "Goa", "01/11/2030", "10:00"));
+
+    HoldResult kept = system.hold("HX1", "B1", 60);
+    CHECK(kept.success);
+    CHECK(system.confirmHold(kept.holdId, "P1000").success);
+
+    HoldResult lapsed = system.hold("HX1", "A1", 1);
+    CHECK(lapsed.success);
+    CHECK(!seatFree(system, "HX1", "A1"));
+    CHECK(!system.book("P1000", "HX1", "A1").success);
+    for (int i = 0; i < 50 && system.activeHolds() > 0; i++) this_thread::sleep_for(chrono::milliseconds(100));
+    CHECK(system.activeHolds() == 0);
+    CHECK(seatFree(system, "HX1", "A1"));
+    BookingResult late = system.confirmHold(lapsed.holdId, "P1000");
+    CHECK(!late.success);
+    CHECK(system.bookingCount("P1000") == 1);
+    CHECK(system.book("P1000", "HX1", "A1").success);
+}
+
+// Removal is refused while seats are booked or held, with the reason; held
+// seats are not counted as booked.
+static void testRemoveFlight() {
+    string dir = scratchDir("remove_flight");
+    ReservationSystem system(dir, false);
+    system.importPassenger(testPassenger("P1000"));
+    system.addFlight(testFlight("RF1", "Pune", "Goa", "01/11/2030", "10:00"));
+
+    HoldResult held = system.hold("RF1", "A1", 60);
+    CHECK(held.success);
+    vector<FlightOccupancy> occupancy = system.flightOccupancy();
+    CHECK(occupancy.size() == 1 && occupancy[0].bookedSeats == 0 && occupancy[0].heldSeats == 1);
+    OperationResult removed = system.removeFlight("RF1");
+    CHECK(!removed.success);
+    CHECK(removed.error == "Cannot remove flight with seats on hold!");
+    CHECK(system.confirmHold(held.holdId, "P1000").success);
+    removed = system.removeFlight("RF1");
+    CHECK(!removed.success);
+    CHECK(removed.error == "Cannot remove flight with active bookings!");
+
+    vector<Booking> bookings = system.bookingsForPassenger("P1000");
+    CHECK(bookings.size() == 1);
+    if (!bookings.empty()) CHECK(system.cancel(bookings[0].getBookingId()).success);
+    CHECK(system.removeFlight("RF1").success);
+}
+
+// A failed journal write is reported until a rotation moves the log with
+// the gap aside and the fresh one is written cleanly.
+static void testJournalFailure() {
+    string dir = scratchDir("journal_failure") + "/missing";
+    Journal journal(dir + "/journal.log");
+    CHECK(!journal.append("C|1"));
+    filesystem::create_directories(dir);
+    CHECK(!journal.append("C|2"));
+    journal.rotate();
+    CHECK(journal.awaitRotation());
+    CHECK(journal.append("C|3"));
+    CHECK(journal.append(vector<string>{"C|4", "C|5"}));
+
+    string replayed;
+    journal.replay([&](char type, const string& body) { replayed += string(1, type) + body + " "; });
+    CHECK(replayed == "C2 C3 C4 C5 ");
+}
+
+// Record text lives in the system's own arena: it survives the source
+// record going away, and clearing and reloading gives the same users back.
+static void testReloadText() {
+    string dir = scratchDir("reload_text");
+    ReservationSystem system(dir, false);
+    {
+        Passenger imported = testPassenger("P2000");
+        system.importPassenger(imported);
+    }
+    OperationResult registered = system.registerPassenger("Reload Tester", "reload@example.com",
+                                                          "9876543210", "PP9", "secret");
+    CHECK(registered.success);
+    system.saveAllData();
+    for (int i = 0; i < 3; i++) {
+        system.clearData();
+        CHECK(!system.authenticatePassenger("P2000", "pass"));
+        system.loadAllData();
+        Passenger* p = system.authenticatePassenger("P2000", "pass");
+        CHECK(p && p->getName() == "Test P2000" && p->getEmail() == "P2000@example.com");
+        p = system.authenticatePassenger(registered.id, "secret");
+        CHECK(p && p->getName() == "Reload Tester");
+    }
+}
+
+// Adding and removing flights keeps each route in departure-time order,
+// and a date written without leading zeros finds the same day.
+static void testRouteSearch() {
+    string dir = scratchDir("route_search");
+    ReservationSystem system(dir, false);
+    system.addFlight(testFlight("RS3", "Pune", "Goa", "01/11/2030", "18:00"));
+    system.addFlight(testFlight("RS1", "Pune", "Goa", "01/11/2030", "06:00"));
+    system.addFlight(testFlight("RS2", "Pune", "Goa", "01/11/2030", "12:00"));
+    system.addFlight(testFlight("RS4", "Pune", "Goa", "02/11/2030", "12:00"));
+    system.addFlight(testFlight("RS5", "Goa", "Pune", "01/11/2030", "12:00"));
+    system.addFlight(testFlight("RS6", "Pune", "Goa", "2/11/2030", "08:00"));
+    system.addFlight(testFlight("RS7", "Goa", "Delhi", "02/11/2030", "08:00"));
+
+    auto numbers = [&](const string& date) {
+        string out;
+        for (const Flight& f : system.searchFlights({"Pune", "Goa", date})) out += f.getFlightNumber() + " ";
+        return out;
+    };
+    CHECK(numbers("01/11/2030") == "RS1 RS2 RS3 ");
+    CHECK(numbers("1/11/2030") == "RS1 RS2 RS3 ");
+    CHECK(numbers("02/11/2030") == "RS6 RS4 ");
+    CHECK(system.searchFlights({"Pune", "Nowhere", "01/11/2030"}).empty());
+
+    // Overnight connections; RS5 would return to the origin.
+    ConnectionQuery query;
+    query.origin = "Pune";
+    query.destination = "Delhi";
+    query.date = "1/11/2030";
+    string itineraries;
+    for (const Itinerary& it : system.searchConnections(query)) {
+        for (const Flight& leg : it.legs) itineraries += leg.getFlightNumber() + " ";
+        itineraries += "| ";
+    }
+    CHECK(itineraries == "RS1 RS7 | RS2 RS7 | RS3 RS7 | ");
+    CHECK(system.removeFlight("RS2").success);
+    CHECK(numbers("01/11/2030") == "RS1 RS3 ");
+    CHECK(system.removeFlight("RS4").success);
+    CHECK(numbers("02/11/2030") == "RS6 ");
+    Flight f;
+    CHECK(!system.getFlight("RS4", f) && system.getFlight("RS5", f));
+    CHECK(system.listFlights().size() == 5);
+}
+
+// Rebuilt report totals count confirmed and cancelled bookings only; a
+// booking with any other status is neither. Routes and airlines are named
+// in the report and in the revenue analytics.
+static void testReportTotals() {
+    string dir = scratchDir("report_totals");
+    {
+        ReservationSystem system(dir, false);
+        system.importPassenger(testPassenger("P1000"));
+        system.addFlight(testFlight("RT1", "Pune", "Goa", "01/11/2030", "10:00"));
+        system.addFlight(Flight("RT2", "Other Air", "Goa", "Delhi", "01/11/2030", "12:00", "14:00", 60, 400.0));
+        CHECK(system.book("P1000", "RT2", "A1").success);
+        CHECK(system.book("P1000", "RT2", "A2").success);
+        CHECK(system.book("P1000", "RT1", "A1").success);
+        BookingResult cancelled = system.book("P1000", "RT1", "B1");
+        CHECK(cancelled.success && system.cancel(cancelled.booking.getBookingId()).success);
+    }
+    ofstream(dir + "/bookings.txt", ios::app) << "TXN9999|P1000|RT1|C1|01/10/2030|1000.000000|PENDING\n";
+
+    ReservationSystem system(dir, false);
+    SystemReport report = system.generateReport();
+    CHECK(report.confirmedBookings == 3);
+    CHECK(report.cancelledBookings == 1);
+    CHECK(report.totalRevenue == 1800.0);
+    CHECK(report.topRoutes.size() == 2 && report.topRoutes[0].first == "Goa -> Delhi" &&
+          report.topRoutes[0].second == 2 && report.topRoutes[1].first == "Pune -> Goa");
+    CHECK(report.airlines.size() == 2 && report.airlines[0].first == "Test Air" &&
+          report.airlines[1].first == "Other Air" && report.airlines[1].second.revenue == 800.0);
+
+    const BookingColumns& columns = system.analytics();
+    vector<pair<string, double>> routes = columns.revenueByRoute();
+    CHECK(routes.size() == 2 && routes[0] == make_pair(string("Pune -> Goa"), 1000.0) &&
+          routes[1] == make_pair(string("Goa -> Delhi"), 800.0));
+    vector<pair<string, double>> airlines = columns.revenueByAirline();
+    CHECK(airlines.size() == 2 && airlines[0].first == "Test Air" && airlines[1].first == "Other Air");
+}
+
+// Bookings survive a binary snapshot exactly, including IDs, seats and
+// statuses that are not in their usual form, and the snapshot's string
+// table does not grow with the number of bookings.
+static void testBinarySnapshot() {
+    string dir = scratchDir("binary_snapshot");
+    auto stringTableSize = [&]() {  // count of the first directory entry
+        ifstream file(dir + "/snapshot.bin", ios::binary);
+        unsigned char count[4] = {};
+        file.seekg(24);
+        file.read((char*)count, 4);
+        return count[0] | count[1] << 8 | count[2] << 16 | (uint32_t)count[3] << 24;
+    };
+    string expected;
+    uint32_t fewStrings = 0;
+    {
+        ReservationSystem system(dir, false);
+        system.importPassenger(testPassenger("P1000"));
+        system.addFlight(testFlight("BS1", "Pune", "Goa", "01/11/2030", "10:00", 200));
+        for (int i = 0; i < 4; i++) CHECK(system.autoBook("P1000", "BS1").success);
+        system.setSnapshotFormat(SnapshotFormat::Binary);
+        CHECK(system.saveAllData());
+        fewStrings = stringTableSize();
+        for (int i = 0; i < 100; i++) CHECK(system.autoBook("P1000", "BS1").success);
+        vector<Booking> booked = system.bookingsForPassenger("P1000");
+        CHECK(system.cancel(booked[0].getBookingId()).success);
+        CHECK(system.saveAllData());
+        CHECK(stringTableSize() == fewStrings);
+    }
+    {
+        // A text snapshot with the unusual forms, then converted.
+        ReservationSystem system(dir, false);
+        system.setSnapshotFormat(SnapshotFormat::Text);
+        CHECK(system.saveAllData());
+    }
+    ofstream(dir + "/bookings.txt", ios::app)
+        << "LEGACY7|P1000|BS1|a9|1/10/2030|1000.000000|PENDING\n"
+        << "TXN9999|P1000|BS1|J9|01/10/2030|1000.000000|WAITLISTED\n";
+    {
+        ReservationSystem system(dir, false);
+        for (const Booking& b : system.listBookings()) expected += b.toFileString() + "\n";
+        system.setSnapshotFormat(SnapshotFormat::Binary);
+        CHECK(system.saveAllData());
+    }
+    ReservationSystem system(dir, false);
+    CHECK(system.getSnapshotFormat() == SnapshotFormat::Binary);
+    string loaded;
+    for (const Booking& b : system.listBookings()) loaded += b.toFileString() + "\n";
+    CHECK(loaded == expected);
+    CHECK(expected.find("LEGACY7|P1000|BS1|a9|1/10/2030") != string::npos);
+    CHECK(expected.find("WAITLISTED") != string::npos);
+}
+
+// Every kernel the CPU supports agrees with the scalar one, including on
+// lengths that leave a tail.
+static void testSimdKernels() {
+    mt19937 random(7);
+    vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (activeSimdLevel() != SimdLevel::Scalar) levels.push_back(SimdLevel::SSE2);
+    if (activeSimdLevel() == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+
+    const size_t groups = 13;
+    for (size_t n : {0, 1, 7, 8, 9, 31, 1000, 4099}) {
+        vector<uint8_t> status(n);
+        vector<double> fare(n);
+        vector<uint32_t> keys(n);
+        vector<uint32_t> keyGroup(50);
+        for (size_t i = 0; i < n; i++) {
+            status[i] = (uint8_t)(random() % 3);
+            fare[i] = (double)(random() % 100000) / 7.0;
+            keys[i] = (uint32_t)(random() % keyGroup.size());
+        }
+        for (auto& g : keyGroup) g = (uint32_t)(random() % groups);
+
+        StatusTotals expected = sumStatusScalar(status.data(), fare.data(), n);
+        vector<double> expectedSums(groups, 0.0);
+        sumByGroupScalar(status.data(), fare.data(), keys.data(), keyGroup.data(), n, expectedSums.data());
+        for (SimdLevel level : levels) {
+            StatusTotals totals = sumStatus(status.data(), fare.data(), n, level);
+            CHECK(totals.confirmed == expected.confirmed);
+            CHECK(totals.cancelled == expected.cancelled);
+            CHECK(fabs(totals.revenue - expected.revenue) <= 1e-9 * max(1.0, expected.revenue));
+            vector<double> sums(groups, 0.0);
+            sumByGroup(status.data(), fare.data(), keys.data(), keyGroup.data(), n, sums.data(), groups, level);
+            for (size_t g = 0; g < groups; g++) {
+                CHECK(fabs(sums[g] - expectedSums[g]) <= 1e-9 * max(1.0, expectedSums[g]));
+            }
+        }
+    }
+}
+
+// A data directory that cannot be created, or whose shard count cannot be
+// recorded, is an error. The same operations on a 4-shard router and on one
+// system give the same bookings, seats, searches and report.
+static void testShardedRouter() {
+    string blocked = scratchDir("sharded_router_blocked") + "/file";
+    ofstream(blocked) << "not a directory\n";
+    bool refused = false;
+    try {
+        ShardedReservationSystem unusable(blocked + "/data", 2);
+    } catch (const runtime_error&) {
+        refused = true;
+    }
+    CHECK(refused);
+
+    string unwritable = scratchDir("sharded_router_unwritable");
+    filesystem::create_directories(unwritable + "/shards.txt.tmp");  // blocks the count file
+    refused = false;
+    try {
+        ShardedReservationSystem unusable(unwritable, 2);
+    } catch (const runtime_error&) {
+        refused = true;
+    }
+    CHECK(refused);
+
+    string shardedDir = scratchDir("sharded_router");
+    string singleDir = scratchDir("sharded_router_single");
+    ShardedReservationSystem sharded(shardedDir, 4);
+    ReservationSystem single(singleDir, false);
+
+    OperationResult registered = sharded.registerPassenger("Router Test", "router@example.com",
+                                                           "9876543210", "PPR1", "pass");
+    CHECK(registered.success);
+    single.importPassenger(Passenger(registered.id, "pass", "Router Test", "router@example.com",
+                                     "9876543210", "PPR1"));
+    const char* cities[] = {"Pune", "Goa", "Delhi"};
+    for (int i = 0; i < 12; i++) {
+        Flight f = testFlight("SR" + to_string(i), cities[i % 3], cities[(i + 1) % 3],
+                              "0" + to_string(1 + i % 2) + "/11/2030", to_string(10 + i) + ":00", 24);
+        CHECK(sharded.addFlight(f).success);
+        CHECK(single.addFlight(f).success);
+    }
+    for (int i = 0; i < 400; i++) {
+        string flight = "SR" + to_string(i % 12);
+        BookingResult a = sharded.autoBook(registered.id, flight);
+        BookingResult b = single.autoBook(registered.id, flight);
+        CHECK(a.success == b.success);
+        if (a.success && b.success) {
+            CHECK(a.booking.getSeatNumber() == b.booking.getSeatNumber());
+            if (i % 3 == 0) {
+                CHECK(sharded.cancel(a.booking.getBookingId()).success);
+                CHECK(single.cancel(b.booking.getBookingId()).success);
+            }
+        }
+    }
+    CHECK(sharded.removeFlight("SR11").success == single.removeFlight("SR11").success);
+
+    CHECK(sharded.bookingCount(registered.id) == single.bookingCount(registered.id));
+    for (const Flight& f : single.listFlights()) {
+        Flight routed;
+        CHECK(sharded.getFlight(f.getFlightNumber(), routed));
+        CHECK(routed.getAvailableSeats() == f.getAvailableSeats());
+    }
+    CHECK(sharded.listFlights().size() == single.listFlights().size());
+    for (int i = 0; i < 3; i++) {
+        for (bool onlyAvailable : {true, false}) {
+            FlightQuery query;
+            query.origin = cities[i];
+            query.destination = cities[(i + 1) % 3];
+            query.date = "01/11/2030";
+            query.onlyAvailable = onlyAvailable;
+            vector<string> a, b;
+            for (const Flight& f : sharded.searchFlights(query)) a.push_back(f.getFlightNumber());
+            for (const Flight& f : single.searchFlights(query)) b.push_back(f.getFlightNumber());
+            CHECK(a == b);
+        }
+    }
+    SystemReport a = sharded.generateReport();
+    SystemReport b = single.generateReport();
+    CHECK(a.totalFlights == b.totalFlights);
+    CHECK(a.totalBookings == b.totalBookings);
+    CHECK(a.confirmedBookings == b.confirmedBookings);
+    CHECK(a.cancelledBookings == b.cancelledBookings);
+    CHECK(a.totalSeats == b.totalSeats);
+    CHECK(a.bookedSeats == b.bookedSeats);
+    CHECK(fabs(a.totalRevenue - b.totalRevenue) < 1e-6);
+    CHECK(a.topRoutes == b.topRoutes);
+}
+
+int main(int argc, char* argv[]) {
+    const vector<pair<string, void (*)()>> cases = {
+        {"crash_replay", testCrashReplay},
+        {"torn_group", testTornGroup},
+        {"torn_append", testTornAppend},
+        {"torn_group_append", testTornGroupAppend},
+        {"batch_rollback", testBatchRollback},
+        {"hold_expiry", testHoldExpiry},
+        {"journal_failure", testJournalFailure},
+        {"unsaved_change", testUnsavedChange},
+        {"remove_flight", testRemoveFlight},
+        {"reload_text", testReloadText},
+        {"route_search", testRouteSearch},
+        {"report_totals", testReportTotals},
+        {"binary_snapshot", testBinarySnapshot},
+        {"simd_kernels", testSimdKernels},
+        {"sharded_router", testShardedRouter},
+    };
+    string only = argc > 1 ? argv[1] : "";
+    bool found = false;
+    for (const auto& c : cases) {
+        if (!only.empty() && c.first != only) continue;
+        found = true;
+        int before = failures;
+        c.second();
+        cout << c.first << ": " << (failures == before ? "ok" : "FAILED") << endl;
+    }
+    if (!found) {
+        cerr << "unknown test case: " << only << endl;
+        return 2;
+    }
+    return failures == 0 ? 0 : 1;
+}